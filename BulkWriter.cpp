@@ -0,0 +1,181 @@
+/****************************************************************************/
+/* BEGIN FILE             BulkWriter.cpp                                    */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Parallel generation of many small documents.                      */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        Workers claim documents in batches from a shared atomic index and */
+/*        publish their totals through atomics read by the progress loop.  */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "BulkWriter.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+static const unsigned long long BatchSize = 64;
+static constexpr size_t CacheLine = 64;
+
+/**
+* Write a whole file in as few system calls as possible.
+* @param path  the file, created or truncated.
+* @param text  its contents.
+*/
+static bool writeFile (const string& path, const string& text) {
+#ifdef _WIN32
+    FILE* f = fopen (path.c_str (), "wb");
+    if (f == nullptr)
+        return false;
+    setvbuf (f, nullptr, _IONBF, 0);
+    bool ok = fwrite (text.data (), 1, text.size (), f) == text.size ();
+    return fclose (f) == 0 && ok;
+#else
+    const int fd = open (path.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    size_t done = 0;
+    while (done < text.size ()) {
+        const ssize_t n = pwrite (fd, text.data () + done, text.size () - done, (off_t) done);
+        if (n <= 0)
+            break;
+        done += (size_t) n;
+    }
+    return close (fd) == 0 && done == text.size ();
+#endif
+}
+
+/****************************************************************************/
+
+/**
+* Path of a document: directory/prefix + 1-based zero padded number + extension.
+* @param options  the run description.
+* @param index    0-based document number.
+*/
+string BulkWriter::fileName (const BulkOptions& options, unsigned long long index) {
+    int width = 6;
+    for (unsigned long long n = options.count; n >= 1000000; n /= 10)
+        width++;
+    char number[32];
+    snprintf (number, sizeof (number), "%0*llu", width, index + 1);
+    return options.directory + "/" + options.prefix + number + options.extension;
+}
+
+/**
+* Generate and write all documents, blocking until done.
+* @param options   the run description; the directory must exist.
+* @param progress  called about once a second, and once at the end, on the calling thread.
+* @return the final totals.
+*/
+BulkProgress BulkWriter::run (const BulkOptions& options, const function<void (const BulkProgress&)>& progress) {
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now ();
+    // Each shared counter on a line of its own; the workers' Random are aligned likewise.
+    alignas (CacheLine) atomic<unsigned long long> next (0);
+    alignas (CacheLine) atomic<unsigned long long> files (0);
+    alignas (CacheLine) atomic<unsigned long long> bytes (0);
+    alignas (CacheLine) atomic<unsigned long long> failures (0);
+    mutex doneMutex;
+    condition_variable doneSignal;
+    int running;
+    const LoremGenerator builtin;
+    const LoremGenerator& generator = options.generator != nullptr ? *options.generator : builtin;
+
+    auto worker = [&] () {
+        LoremSettings settings = options.settings;
+        Random random;
+        LoremStats stats;
+        string text;
+
+        for (;;) {
+            const unsigned long long first = next.fetch_add (BatchSize);
+            if (first >= options.count)
+                break;
+            const unsigned long long last = first + BatchSize < options.count ? first + BatchSize : options.count;
+            unsigned long long written = 0;
+            unsigned long long size = 0;
+            for (unsigned long long i = first; i < last; i++) {
+                random.set_seed (options.seed + i);
+                text.clear ();
+                if (options.layout != nullptr) {
+                    options.layout->render (generator, settings, random, stats, text);
+                } else {
+                    settings.paragraphCount = options.minParagraphs;
+                    if (options.maxParagraphs > options.minParagraphs)
+                        settings.paragraphCount += random.uniform (2, 0, options.maxParagraphs - options.minParagraphs);
+                    generator.appendParagraphs (text, settings, random, stats);
+                }
+                if (writeFile (fileName (options, i), text)) {
+                    written++;
+                    size += text.size ();
+                }
+            }
+            // Totals are published once per batch to keep the shared counters cold.
+            files += written;
+            bytes += size;
+            failures += (last - first) - written;
+        }
+
+        lock_guard<mutex> lock (doneMutex);
+        running--;
+        doneSignal.notify_one ();
+    };
+
+    int threads = options.threads > 0 ? options.threads : (int) thread::hardware_concurrency ();
+    if (threads <= 0)
+        threads = 1;
+    running = threads;
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back (worker);
+
+    auto snapshot = [&] () {
+        BulkProgress p;
+        p.files = files;
+        p.bytes = bytes;
+        p.failures = failures;
+        p.seconds = chrono::duration<double> (chrono::steady_clock::now () - start).count ();
+        return p;
+    };
+
+    {
+        unique_lock<mutex> lock (doneMutex);
+        while (!doneSignal.wait_for (lock, chrono::seconds (1), [&running] { return running == 0; }))
+            if (progress) {
+                lock.unlock ();
+                progress (snapshot ());
+                lock.lock ();
+            }
+    }
+    for (thread& t : pool)
+        t.join ();
+
+    const BulkProgress result = snapshot ();
+    if (progress)
+        progress (result);
+    return result;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     BulkWriter.h                                        */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     Generates many separate documents (doc_000001.txt ...) into a         */
+/*     directory on a pool of worker threads, for load testing.              */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     Document i is generated from random streams seeded with seed + i, so  */
+/*     the files are identical whatever the thread count.  All workers      */
+/*     share one const generator; each reuses its own Random, stats and     */
+/*     buffer and writes each file with a single write call, i.e.           */
+/*     open/write/close per file.                                           */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _BULKWRITER_H_
+#define   _BULKWRITER_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include "LoremGenerator.h"
+#include "LoremTemplate.h"
+
+/**
+* What to generate and where.
+* Without a layout each document is minParagraphs to maxParagraphs paragraphs, uniformly.
+* Without a generator the built in dictionary is used.
+*/
+struct BulkOptions {
+	std::string directory;
+	std::string prefix = "doc_";
+	std::string extension = ".txt";
+	unsigned long long count = 0;
+	int minParagraphs = 1;
+	int maxParagraphs = 1;
+	unsigned long long seed = 0;
+	int threads = 0;
+	LoremSettings settings;
+	const LoremGenerator* generator = nullptr;
+	const LoremTemplate* layout = nullptr;
+};
+
+/**
+* Running totals, reported while the run is in progress and at its end.
+*/
+struct BulkProgress {
+	unsigned long long files = 0;
+	unsigned long long bytes = 0;
+	unsigned long long failures = 0;
+	double seconds = 0.0;
+};
+
+
+class BulkWriter {
+
+public:
+	static BulkProgress run (const BulkOptions& options,
+	                         const std::function<void (const BulkProgress&)>& progress = nullptr);
+
+	static std::string fileName (const BulkOptions& options, unsigned long long index);
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    BulkWriter.h                                           */
+/*****************************************************************************/
@@ -0,0 +1,295 @@
+/****************************************************************************/
+/* BEGIN FILE             CompressedWriter.cpp                              */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Pipelined plain/gzip/zstd file output.                            */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        gzip framing comes from zlib's deflate with windowBits 16+15.     */
+/*        Each library is optional: LOREM_HAVE_ZLIB and LOREM_HAVE_ZSTD.    */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#ifdef LOREM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LOREM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+#include "CompressedWriter.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+static const size_t OutputBufferSize = 256 * 1024;
+
+/****************************************************************************/
+
+/**
+* Choose the output format from a file name: ".gz" is gzip, ".zst" is zstd, anything else plain.
+* @param path  the output file name.
+*/
+CompressedWriter::Format CompressedWriter::formatFor (const string& path) {
+    auto endsWith = [&path] (const char* ext) {
+        const string e (ext);
+        return path.size () >= e.size () && path.compare (path.size () - e.size (), e.size (), e) == 0;
+    };
+    if (endsWith (".gz"))
+        return Gzip;
+    if (endsWith (".zst"))
+        return Zstd;
+    return Plain;
+}
+
+/**
+* Was support for the format compiled in?
+*/
+bool CompressedWriter::isAvailable (Format format) {
+#ifndef LOREM_HAVE_ZLIB
+    if (format == Gzip)
+        return false;
+#endif
+#ifndef LOREM_HAVE_ZSTD
+    if (format == Zstd)
+        return false;
+#endif
+    (void) format;
+    return true;
+}
+
+/**
+* Open the file and start the compression thread.
+* Check isOpen() afterwards.
+* @param path        the output file.
+* @param format      Plain, Gzip or Zstd.
+* @param queueDepth  chunks allowed to wait for the compressor before write() blocks.
+* @param level       compression level, -1 for the library default.
+*/
+CompressedWriter::CompressedWriter (const string& path, Format format, size_t queueDepth, int level)
+    : format (format), level (level), queueDepth (queueDepth > 0 ? queueDepth : 1) {
+    if (init ())
+        open (fopen (path.c_str (), "wb"), true);
+}
+
+/**
+* Write to an already open stream, such as stdout, and start the compression thread.
+* The stream is flushed but not closed by close().  Check isOpen() afterwards.
+* On Windows a compressed stream is switched to binary mode, since a text mode
+* stream would turn every 0x0A byte of the output into CR LF.
+* @param stream      the output stream.
+* @param format      Plain, Gzip or Zstd.
+* @param queueDepth  chunks allowed to wait for the compressor before write() blocks.
+* @param level       compression level, -1 for the library default.
+*/
+CompressedWriter::CompressedWriter (FILE* stream, Format format, size_t queueDepth, int level)
+    : format (format), level (level), queueDepth (queueDepth > 0 ? queueDepth : 1) {
+    if (!init ())
+        return;
+#ifdef _WIN32
+    if (stream != nullptr && format != Plain) {
+        fflush (stream);
+        _setmode (_fileno (stream), _O_BINARY);
+    }
+#endif
+    open (stream, false);
+}
+
+/**
+* Default Destructor. Finishes the stream if close() was not called.
+*/
+CompressedWriter::~CompressedWriter () {
+    close ();
+#ifdef LOREM_HAVE_ZLIB
+    if (zs != nullptr) {
+        deflateEnd (zs);
+        delete zs;
+    }
+#endif
+#ifdef LOREM_HAVE_ZSTD
+    if (zcc != nullptr)
+        ZSTD_freeCCtx (zcc);
+#endif
+}
+
+/**
+* Queue a chunk for the compression thread, waiting while the queue is full.
+* @param chunk  the text; it is moved from.
+* @return false once an error has occurred, the caller should stop generating.
+*/
+bool CompressedWriter::write (string&& chunk) {
+    if (file == nullptr)
+        return false;
+    unique_lock<std::mutex> lock (mutex);
+    notFull.wait (lock, [this] { return queue.size () < queueDepth || failed; });
+    if (failed)
+        return false;
+    inCount += chunk.size ();
+    queue.push_back (std::move (chunk));
+    notEmpty.notify_one ();
+    return true;
+}
+
+/**
+* Drain the queue, finish the compressed stream and close the file.
+* @return true if everything was written.
+*/
+bool CompressedWriter::close () {
+    if (file == nullptr)
+        return false;
+    {
+        lock_guard<std::mutex> lock (mutex);
+        closing = true;
+    }
+    notEmpty.notify_one ();
+    worker.join ();
+
+    bool ok = !failed;
+    if ((ownsFile ? fclose (file) : fflush (file)) != 0)
+        ok = false;
+    file = nullptr;
+    return ok;
+}
+
+// Private
+
+/**
+* Set up the compressor for the format.
+* @return false if the format is not available or the library failed.
+*/
+bool CompressedWriter::init () {
+    if (!isAvailable (format))
+        return false;
+
+#ifdef LOREM_HAVE_ZLIB
+    if (format == Gzip) {
+        zs = new z_stream ();
+        if (deflateInit2 (zs, level < 0 ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete zs;
+            zs = nullptr;
+            return false;
+        }
+    }
+#endif
+#ifdef LOREM_HAVE_ZSTD
+    if (format == Zstd) {
+        zcc = ZSTD_createCCtx ();
+        if (zcc == nullptr)
+            return false;
+        ZSTD_CCtx_setParameter (zcc, ZSTD_c_compressionLevel, level < 0 ? ZSTD_CLEVEL_DEFAULT : level);
+    }
+#endif
+    return true;
+}
+
+/**
+* Take over the output stream and start the compression thread.
+* @param stream  the output, nullptr if it could not be opened.
+* @param owned   close the stream when done, rather than just flushing it.
+*/
+void CompressedWriter::open (FILE* stream, bool owned) {
+    file = stream;
+    ownsFile = owned;
+    if (file == nullptr)
+        return;
+    buffer.resize (OutputBufferSize);
+    worker = thread (&CompressedWriter::run, this);
+}
+
+/**
+* Compression thread: take chunks off the queue until close() and it is empty.
+*/
+void CompressedWriter::run () {
+    for (;;) {
+        string chunk;
+        {
+            unique_lock<std::mutex> lock (mutex);
+            notEmpty.wait (lock, [this] { return !queue.empty () || closing; });
+            if (queue.empty ())
+                break;
+            chunk = std::move (queue.front ());
+            queue.pop_front ();
+        }
+        notFull.notify_one ();
+
+        if (!failed && !compress (chunk, false)) {
+            lock_guard<std::mutex> lock (mutex);
+            failed = true;
+            notFull.notify_all ();
+        }
+    }
+    if (!failed && !compress (string (), true)) {
+        lock_guard<std::mutex> lock (mutex);
+        failed = true;
+    }
+}
+
+/**
+* Compress a chunk (or finish the stream) and write out the result.
+* @param chunk   input text.
+* @param finish  true after the last chunk to flush the compressor's trailer.
+*/
+bool CompressedWriter::compress (const string& chunk, bool finish) {
+    if (format == Plain)
+        return chunk.empty () || emit (chunk.data (), chunk.size ());
+
+#ifdef LOREM_HAVE_ZLIB
+    if (format == Gzip) {
+        zs->next_in = (Bytef*) chunk.data ();
+        zs->avail_in = (uInt) chunk.size ();
+        int rc;
+        do {
+            zs->next_out = (Bytef*) buffer.data ();
+            zs->avail_out = (uInt) buffer.size ();
+            rc = deflate (zs, finish ? Z_FINISH : Z_NO_FLUSH);
+            if (rc == Z_STREAM_ERROR)
+                return false;
+            if (!emit (buffer.data (), buffer.size () - zs->avail_out))
+                return false;
+        } while (zs->avail_out == 0 || (finish && rc != Z_STREAM_END));
+        return true;
+    }
+#endif
+
+#ifdef LOREM_HAVE_ZSTD
+    ZSTD_inBuffer in = { chunk.data (), chunk.size (), 0 };
+    size_t remaining;
+    do {
+        ZSTD_outBuffer out = { buffer.data (), buffer.size (), 0 };
+        remaining = ZSTD_compressStream2 (zcc, &out, &in, finish ? ZSTD_e_end : ZSTD_e_continue);
+        if (ZSTD_isError (remaining))
+            return false;
+        if (!emit (buffer.data (), out.pos))
+            return false;
+    } while (finish ? remaining != 0 : in.pos < in.size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+* Write bytes to the file.
+*/
+bool CompressedWriter::emit (const char* data, size_t size) {
+    if (size == 0)
+        return true;
+    outCount += size;
+    return fwrite (data, 1, size, file) == size;
+}
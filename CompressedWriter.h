@@ -0,0 +1,100 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     CompressedWriter.h                                  */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     Writes generated text to a file, optionally gzip or zstd compressed,  */
+/*     on a thread of its own so that generation and compression overlap.    */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     The generator hands over chunks through a bounded queue; write()      */
+/*     blocks once the queue is full so memory use stays at roughly          */
+/*     queueDepth chunks no matter how large the document is.               */
+/*     gzip support is compiled in when LOREM_HAVE_ZLIB is defined, zstd     */
+/*     support when LOREM_HAVE_ZSTD is.                                      */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _COMPRESSEDWRITER_H_
+#define   _COMPRESSEDWRITER_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct z_stream_s;
+struct ZSTD_CCtx_s;
+
+
+class CompressedWriter {
+
+public:
+	enum Format { Plain, Gzip, Zstd };
+
+	static Format formatFor (const std::string& path);
+	static bool isAvailable (Format format);
+
+	CompressedWriter (const std::string& path, Format format, size_t queueDepth = 8, int level = -1);
+	CompressedWriter (FILE* stream, Format format, size_t queueDepth = 8, int level = -1);
+	~CompressedWriter ();
+
+	bool isOpen () const { return file != nullptr; }
+	bool write (std::string&& chunk);
+	bool close ();
+
+	unsigned long long bytesIn () const { return inCount; }
+	unsigned long long bytesOut () const { return outCount; }
+
+private:
+	CompressedWriter (const CompressedWriter&) = delete;
+	CompressedWriter& operator= (const CompressedWriter&) = delete;
+
+	FILE* file = nullptr;
+	bool ownsFile = false;
+	Format format;
+	int level;
+	z_stream_s* zs = nullptr;
+	ZSTD_CCtx_s* zcc = nullptr;
+	std::vector<char> buffer;
+
+	std::mutex mutex;
+	std::condition_variable notFull;
+	std::condition_variable notEmpty;
+	std::deque<std::string> queue;
+	size_t queueDepth;
+	bool closing = false;
+	bool failed = false;
+	std::thread worker;
+
+	unsigned long long inCount = 0;
+	unsigned long long outCount = 0;
+
+	bool init ();
+	void open (FILE* stream, bool owned);
+	void run ();
+	bool compress (const std::string& chunk, bool finish);
+	bool emit (const char* data, size_t size);
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    CompressedWriter.h                                     */
+/*****************************************************************************/
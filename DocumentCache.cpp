@@ -0,0 +1,174 @@
+/****************************************************************************/
+/* BEGIN FILE             DocumentCache.cpp                                 */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Content addressed, size capped on-disk cache of documents.        */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        File layout:  magic | seed_array after generation | text          */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstring>
+#include "DocumentCache.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+static const char CacheMagic[4] = { 'L', 'I', 'C', '1' };
+static const qint64 HeaderSize = sizeof (CacheMagic) + sizeof (seed_array);
+
+/****************************************************************************/
+
+/**
+* Constructor.
+* @param directory  where the entries live; defaults to the per-user cache location.
+* @param maxBytes   size cap, the least recently used entries are evicted beyond it.
+*/
+DocumentCache::DocumentCache (const QString& directory, qint64 maxBytes) : directory (directory), maxBytes (maxBytes) {
+    if (this->directory.isEmpty ())
+        this->directory = QStandardPaths::writableLocation (QStandardPaths::CacheLocation) + QStringLiteral ("/documents");
+    QDir ().mkpath (this->directory);
+}
+
+/**
+* Default Destructor.
+*/
+DocumentCache::~DocumentCache () {
+    // Null
+}
+
+/**
+ * Write multiple paragraphs, from the cache when this exact request was seen before.
+ * On a hit the random streams are advanced just as generating would have.
+ * @param generator  the engine used on a miss.
+ * @param settings   what to generate.
+ * @param random     the random streams of this request.
+ * @param stats      the counters updated on a miss.
+ * @param sink       receives the whole document, on a hit while it is still mapped.
+ * @return what the sink returned.
+ */
+bool DocumentCache::paragraphs (const LoremGenerator& generator, const LoremSettings& settings, Random& random,
+                                LoremStats& stats, const function<bool (string_view)>& sink) {
+    const string fp = generator.fingerprint (settings, random);
+    const QByteArray key = QCryptographicHash::hash (QByteArray::fromRawData (fp.data (), (int) fp.size ()),
+                                                     QCryptographicHash::Sha256).toHex ();
+    seed_array state;
+    bool ok = false;
+
+    if (lookup (key, [&sink, &ok] (string_view text) { ok = sink (text); }, state)) {
+        hitCount++;
+        random.set_state (state);
+        return ok;
+    }
+    missCount++;
+
+    const string text = generator.paragraphs (settings, random, stats);
+    random.get_state (state);
+    store (key, text, state);
+    return sink (text);
+}
+
+/**
+* Fetch an entry through a read-only memory map and mark it as most recently used.
+* A cache that cannot be written, e.g. a shared read-only one, still serves hits;
+* its entries just keep their age.
+* @param key     hex digest naming the entry.
+* @param reader  is given the document while it is mapped, only on a hit.
+* @param state   receives the random stream state following the document.
+* @return true on a hit.
+*/
+bool DocumentCache::lookup (const QByteArray& key, const function<void (string_view)>& reader, seed_array state) {
+    QFile file (pathFor (key));
+    if (!file.open (QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size ();
+    if (size < HeaderSize)
+        return false;
+
+    uchar* data = file.map (0, size);
+    if (data == nullptr)
+        return false;
+
+    bool hit = memcmp (data, CacheMagic, sizeof (CacheMagic)) == 0;
+    if (hit) {
+        memcpy (state, data + sizeof (CacheMagic), sizeof (seed_array));
+        reader (string_view (reinterpret_cast<const char*> (data + HeaderSize), (size_t) (size - HeaderSize)));
+    }
+    file.unmap (data);
+    file.close ();
+
+    // Setting the time needs write access; without it the hit stands and only eviction order suffers.
+    if (hit) {
+        QFile touch (pathFor (key));
+        if (touch.open (QIODevice::ReadWrite | QIODevice::ExistingOnly))
+            touch.setFileTime (QDateTime::currentDateTimeUtc (), QFileDevice::FileModificationTime);
+    }
+    return hit;
+}
+
+/**
+* Add an entry, then trim the cache back under its size cap.
+* The entry is written to a temporary file and renamed so readers never see a partial one.
+* @param key    hex digest naming the entry.
+* @param text   the document.
+* @param state  the random stream state following the document.
+*/
+void DocumentCache::store (const QByteArray& key, const string& text, const seed_array state) {
+    if ((qint64) text.size () + HeaderSize > maxBytes)
+        return;
+
+    QSaveFile file (pathFor (key));
+    if (!file.open (QIODevice::WriteOnly))
+        return;
+    file.write (CacheMagic, sizeof (CacheMagic));
+    file.write (reinterpret_cast<const char*> (state), sizeof (seed_array));
+    file.write (text.data (), (qint64) text.size ());
+    if (file.commit ())
+        evict ();
+}
+
+/**
+* The file holding an entry.
+*/
+QString DocumentCache::pathFor (const QByteArray& key) const {
+    return directory + QLatin1Char ('/') + QString::fromLatin1 (key) + QStringLiteral (".lorem");
+}
+
+/**
+* Remove the least recently used entries until the cache fits its size cap.
+*/
+void DocumentCache::evict () {
+    const QFileInfoList entries = QDir (directory).entryInfoList (QStringList () << QStringLiteral ("*.lorem"),
+                                                                  QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for (const QFileInfo& entry : entries)
+        total += entry.size ();
+
+    // Newest first, so drop from the back.
+    for (qsizetype i = entries.size () - 1; i >= 0 && total > maxBytes; i--) {
+        if (QFile::remove (entries[i].filePath ()))
+            total -= entries[i].size ();
+    }
+}
@@ -0,0 +1,76 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     DocumentCache.h                                     */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     An on-disk cache of generated documents so that identical requests    */
+/*     are served from the page cache instead of being regenerated.          */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     Entries are content addressed by the SHA-256 of the generator         */
+/*     fingerprint (engine version, random stream state, settings and        */
+/*     dictionary).  Each file holds the random stream state reached after   */
+/*     generation followed by the text, so a hit leaves the generator        */
+/*     exactly where a miss would.  Hits are handed to the sink straight     */
+/*     from a memory map; the modification time of a file is its LRU stamp  */
+/*     and the oldest files are evicted past the size cap.                   */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _DOCUMENTCACHE_H_
+#define   _DOCUMENTCACHE_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "LoremGenerator.h"
+
+
+class DocumentCache {
+
+public:
+	static constexpr qint64 DefaultMaxBytes = 256LL * 1024 * 1024;
+
+	DocumentCache (const QString& directory = QString (), qint64 maxBytes = DefaultMaxBytes);
+	~DocumentCache ();
+
+	bool paragraphs (const LoremGenerator& generator, const LoremSettings& settings, Random& random,
+	                 LoremStats& stats, const std::function<bool (std::string_view)>& sink);
+
+	bool lookup (const QByteArray& key, const std::function<void (std::string_view)>& reader, seed_array state);
+	void store (const QByteArray& key, const std::string& text, const seed_array state);
+
+	const QString& location () const { return directory; }
+	unsigned long long hits () const { return hitCount; }
+	unsigned long long misses () const { return missCount; }
+
+private:
+	QString directory;
+	qint64 maxBytes;
+	unsigned long long hitCount = 0;
+	unsigned long long missCount = 0;
+
+	QString pathFor (const QByteArray& key) const;
+	void evict ();
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    DocumentCache.h                                        */
+/*****************************************************************************/
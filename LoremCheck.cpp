@@ -0,0 +1,452 @@
+/****************************************************************************/
+/* BEGIN FILE             LoremCheck.cpp                                    */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Property and fuzz checks of the generator and templates.          */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        Every property is checked against the public API only, the same  */
+/*        way the command line and the window use it.                       */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "LoremCheck.h"
+#include "LoremTemplate.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+static const size_t ProbeChunk = 16 * 1024;
+static const int MaxCheckedCharacters = 2000;
+
+/**
+* Values most likely to break a range check.
+*/
+static const int Interesting[] = { INT_MIN, -1000000000, -1, 0, 1, 2, 3, 5, 17, 99, 100, 101, 1000, 1000000000, INT_MAX };
+
+/**
+* Template fragments, valid and not, that run () strings together.
+*/
+static const char* const Pieces[] = { "{title}", "{byline}", "{words:3}", "{sentence:1-2}", "{para:0-3}", "{list:2-4}",
+                                      "{para:100000}", "{list:9-1}", "{words:-1}", "{nope}", "{", "}", "\\", "\\n",
+                                      "\\q", ":", "-", "x", " " };
+
+/**
+* Field texts that are not plain numbers, as a user might type them.
+*/
+static const char* const Junk[] = { "", " ", "-", "+", "1 2", "12a", "0x10", "1e3", "99999999999", "-2147483649",
+                                    "2147483648", "\xEF\xBC\x95" };
+
+/**
+* Dictionary words, well formed and not, that run () strings together.
+*/
+static const char* const Words[] = { "alpha", "\xC3\xA9t\xC3\xA9", "\xC7\x86" "em", "\xCF\x89\xCE\xBC\xCE\xAD\xCE\xB3\xCE\xB1",
+                                     "\xF0\x9F\x98\x80ok", "\xC3", "ab", "\xF8x", "\xE0\x80\x80", "\xED\xA0\x80",
+                                     "\xC3\xA9t\xC3", "\x80\x80", "\xF4\x90\x80\x80", "\xC0\xA0" };
+
+/**
+* Word separators, ASCII and Unicode.
+*/
+static const char* const Blanks[] = { " ", "\n", "\t\t", "\xC2\xA0", "\xE3\x80\x80", "\r\n", "\xE2\x80\xA8" };
+
+/**
+* Is the text well formed UTF-8?  Written independently of the generator's own repair.
+*/
+static bool isUtf8 (const string& text) {
+    for (size_t i = 0; i < text.size (); ) {
+        const unsigned char c = (unsigned char) text[i];
+        size_t len = c < 0x80 ? 1 : c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF5 ? 4 : 0;
+        if (len == 0 || i + len > text.size ())
+            return false;
+        unsigned long u = len == 1 ? c : c & (0x3F >> (len - 1));
+        for (size_t k = 1; k < len; k++) {
+            if (((unsigned char) text[i + k] & 0xC0) != 0x80)
+                return false;
+            u = (u << 6) | ((unsigned char) text[i + k] & 0x3F);
+        }
+        if ((len == 3 && u < 0x800) || (len == 4 && (u < 0x10000 || u > 0x10FFFF)) || (u >= 0xD800 && u <= 0xDFFF))
+            return false;
+        i += len;
+    }
+    return true;
+}
+
+/**
+* Count the words of a dictionary text: runs of characters outside Unicode's White_Space.
+* Malformed or overlong sequences are never blanks.
+*/
+static size_t wordCount (const string& text) {
+    size_t n = 0;
+    bool inWord = false;
+    for (size_t i = 0; i < text.size (); ) {
+        const unsigned char c = (unsigned char) text[i];
+        size_t len = c < 0x80 ? 1 : c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF5 ? 4 : 0;
+        unsigned long u = len == 1 ? c : c & (0x3F >> (len - 1));
+        for (size_t k = 1; k < len; k++)
+            if (i + k >= text.size () || ((unsigned char) text[i + k] & 0xC0) != 0x80)
+                len = 0;
+            else
+                u = (u << 6) | ((unsigned char) text[i + k] & 0x3F);
+        if ((len == 2 && u < 0x80) || (len == 3 && u < 0x800))
+            len = 0;
+        const bool blank = len != 0 && (u == ' ' || (u >= '\t' && u <= '\r') || u == 0x85 || u == 0xA0 ||
+                                        u == 0x1680 || (u >= 0x2000 && u <= 0x200A) || u == 0x2028 ||
+                                        u == 0x2029 || u == 0x202F || u == 0x205F || u == 0x3000);
+        if (!blank && !inWord)
+            n++;
+        inWord = !blank;
+        i += len != 0 ? len : 1;
+    }
+    return n;
+}
+
+/**
+* What parseInt should make of a text, worked out with the C library.
+* @param expected  receives the number when there is one.
+* @return false if the text is not a whole number that fits an int.
+*/
+static bool parsesAs (const string& text, long long& expected) {
+    auto blank = [] (char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+    size_t begin = 0;
+    size_t end = text.size ();
+    while (begin < end && blank (text[begin]))
+        begin++;
+    while (end > begin && blank (text[end - 1]))
+        end--;
+    const string t = text.substr (begin, end - begin);
+    const size_t digits = !t.empty () && (t[0] == '+' || t[0] == '-') ? 1 : 0;
+    if (t.size () == digits || t.find_first_not_of ("0123456789", digits) != string::npos)
+        return false;
+    errno = 0;
+    expected = strtoll (t.c_str (), nullptr, 10);
+    return errno == 0 && expected >= INT_MIN && expected <= INT_MAX;
+}
+
+/**
+* Take the text up to the next NUL, or the rest of the input.
+*/
+static string section (const uint8_t*& data, size_t& size) {
+    const uint8_t* end = (const uint8_t*) memchr (data, 0, size);
+    const size_t n = end != nullptr ? (size_t) (end - data) : size;
+    const string s ((const char*) data, n);
+    data += n;
+    size -= n;
+    if (size > 0) {
+        data++;
+        size--;
+    }
+    return s;
+}
+
+/**
+* Read a little endian integer of n bytes, or 0 past the end of the input.
+*/
+static unsigned long long take (const uint8_t*& data, size_t& size, size_t n) {
+    unsigned long long value = 0;
+    for (size_t i = 0; i < n && size > 0; i++, size--)
+        value |= (unsigned long long) *data++ << (8 * i);
+    return value;
+}
+
+/**
+* Append a little endian integer of n bytes.
+*/
+static void put (vector<uint8_t>& out, unsigned long long value, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        out.push_back ((uint8_t) (value >> (8 * i)));
+}
+
+/**
+* Describe a request for a failure message.
+*/
+static string describe (const LoremSettings& settings, unsigned long long seed) {
+    char s[160];
+    snprintf (s, sizeof (s), " (words %d-%d, sentences %d-%d, paragraphs %d, standard %d, seed %llu)",
+              settings.minWordCount, settings.maxWordCount, settings.minSentenceCount, settings.maxSentenceCount,
+              settings.paragraphCount, settings.useStandard ? 1 : 0, seed);
+    return s;
+}
+
+/****************************************************************************/
+
+/**
+* Check one request: settings that pass validate must generate text within maxBytes, with
+* the requested shape, identically when streamed and again for the same seed.
+* @param generator  the engine under test.
+* @param settings   the request; invalid settings must be rejected with a reason.
+* @param seed       master seed of the random streams.
+* @param failure    receives a description of the first broken property.
+* @return false if a property does not hold.
+*/
+bool LoremCheck::check (const LoremGenerator& generator, const LoremSettings& settings,
+                        unsigned long long seed, string* failure) {
+    auto fail = [&] (const string& what) {
+        if (failure != nullptr)
+            *failure = what + describe (settings, seed);
+        return false;
+    };
+
+    string error;
+    if (!LoremGenerator::validate (settings, &error))
+        return error.empty () ? fail ("validate rejected the settings without a reason") : true;
+
+    const unsigned long long bound = generator.maxBytes (settings);
+    if (bound > MemoryCeiling) {
+        // Too large to hold in memory: streaming must stop promptly once the sink asks it to.
+        Random random (seed);
+        LoremStats stats;
+        unsigned long long seen = 0;
+        size_t largest = 0;
+        const bool finished = generator.paragraphs (settings, random, stats, ProbeChunk, [&] (string&& chunk) {
+            seen += chunk.size ();
+            largest = chunk.size () > largest ? chunk.size () : largest;
+            return seen < ProbeBytes;
+        });
+        if (finished && seen > bound)
+            return fail ("streamed output exceeds maxBytes");
+        if (finished && stats.paragraphs != (unsigned long long) settings.paragraphCount)
+            return fail ("wrong number of streamed paragraphs");
+        if (!finished && seen < ProbeBytes)
+            return fail ("streaming stopped before the sink asked it to");
+        if (largest > ProbeChunk + bound / (unsigned long long) settings.paragraphCount)
+            return fail ("a streamed chunk is larger than a chunk plus one paragraph");
+        return true;
+    }
+
+    Random random (seed);
+    LoremStats stats;
+    const string text = generator.paragraphs (settings, random, stats);
+    if (text.size () > bound)
+        return fail ("output exceeds maxBytes");
+    if (stats.bytes != text.size ())
+        return fail ("byte counter disagrees with the output");
+    if (!isUtf8 (text))
+        return fail ("output is not valid UTF-8");
+    if (stats.paragraphs != (unsigned long long) settings.paragraphCount)
+        return fail ("wrong number of paragraphs");
+    if (stats.minFragmentWords <= stats.maxFragmentWords &&
+        (stats.minFragmentWords < settings.minWordCount || stats.maxFragmentWords > settings.maxWordCount))
+        return fail ("fragment length outside the configured range");
+    if (stats.minParagraphSentences <= stats.maxParagraphSentences &&
+        (stats.minParagraphSentences < settings.minSentenceCount || stats.maxParagraphSentences > settings.maxSentenceCount))
+        return fail ("paragraph length outside the configured range");
+    if (settings.useStandard && settings.paragraphCount > 0 &&
+        text.compare (0, LoremGenerator::standardParagraph ().size (), LoremGenerator::standardParagraph ()) != 0)
+        return fail ("first paragraph is not the standard one");
+
+    Random again (seed);
+    LoremStats streamedStats;
+    string streamed;
+    generator.paragraphs (settings, again, streamedStats, 1 + (size_t) (seed % 4096), [&streamed] (string&& chunk) {
+        streamed.append (chunk);
+        return true;
+    });
+    if (streamed != text)
+        return fail ("streamed output differs from the same seed generated at once");
+    seed_array first;
+    seed_array second;
+    random.get_state (first);
+    again.get_state (second);
+    if (memcmp (first, second, sizeof (first)) != 0)
+        return fail ("random state differs after streaming");
+
+    const size_t count = (size_t) (seed % MaxCheckedCharacters);
+    Random chars (seed);
+    LoremStats charStats;
+    const string counted = generator.characters (count, settings, chars, charStats);
+    if (LoremGenerator::characterCount (counted) != count)
+        return fail ("characters () returned the wrong number of characters");
+    if (!isUtf8 (counted))
+        return fail ("characters () cut a character in two");
+    return true;
+}
+
+/**
+* Check the request encoded in arbitrary bytes: a standard flag, a 64 bit seed, then
+* NUL separated texts: five settings typed as in the window or on the command line,
+* a dictionary (the Latin one if empty) and, in the rest, a template.
+* @param data     the encoded request.
+* @param size     its length; missing fields are 0 or empty.
+* @param failure  receives a description of the first broken property.
+* @return false if a property does not hold.
+*/
+bool LoremCheck::check (const uint8_t* data, size_t size, string* failure) {
+    LoremSettings settings;
+    settings.useStandard = (take (data, size, 1) & 1) != 0;
+    const unsigned long long seed = take (data, size, 8);
+
+    auto fail = [&] (const string& what) {
+        if (failure != nullptr)
+            *failure = what + describe (settings, seed);
+        return false;
+    };
+
+    // Fields are parsed by the front ends' own parser; text that is not a number keeps the default.
+    int* const fields[] = { &settings.minWordCount, &settings.maxWordCount, &settings.minSentenceCount,
+                            &settings.maxSentenceCount, &settings.paragraphCount };
+    for (int* field : fields) {
+        const string text = section (data, size);
+        long long expected = 0;
+        const int before = *field;
+        const bool parsed = LoremGenerator::parseInt (text, *field);
+        if (parsed != parsesAs (text, expected) || (parsed ? *field != expected : *field != before))
+            return fail ("parseInt (\"" + text + "\") gave " + (parsed ? to_string (*field) : string ("no number")));
+    }
+
+    LoremGenerator generator;
+    const string dictionary = section (data, size);
+    if (!dictionary.empty ()) {
+        // One entry per word, and a text without any leaves the dictionary alone.
+        const size_t before = generator.dictionarySize ();
+        const size_t expected = wordCount (dictionary);
+        const bool loaded = generator.setDictionary (dictionary);
+        if (loaded != (expected > 0) || generator.dictionarySize () != (loaded ? expected : before))
+            return fail ("setDictionary of " + to_string (expected) + " words returned " + (loaded ? "true" : "false") +
+                         " and left " + to_string (generator.dictionarySize ()) + " entries");
+    }
+    const string source ((const char*) data, size);
+
+    // The convenience API must terminate on a reversed range, giving exactly mincount words.
+    const int lo = settings.minWordCount % (2 * LoremGenerator::MaxWordsPerFragment);
+    const int hi = settings.maxWordCount % (2 * LoremGenerator::MaxWordsPerFragment);
+    generator.random.set_seed (seed);
+    const string fragment = generator.sentenceFragment (lo, hi);
+    int words = 0;
+    for (char c : fragment)
+        words += c == ' ';
+    if (hi < lo ? words != max (lo, 0) : words < max (lo, 0) || words > max (hi, 0))
+        return fail ("sentenceFragment (" + to_string (lo) + ", " + to_string (hi) + ") gave " + to_string (words) + " words");
+
+    if (!check (generator, settings, seed, failure))
+        return false;
+
+    LoremTemplate layout;
+    string error;
+    if (!layout.compile (source, &error))
+        return error.empty () ? fail ("template rejected without a reason") : true;
+    const LoremSettings ranges = LoremGenerator::validate (settings) ? settings : LoremSettings ();
+    const unsigned long long bound = layout.maxBytes (generator, ranges);
+    if (bound > MemoryCeiling)
+        return true;
+
+    Random first (seed);
+    Random second (seed);
+    LoremStats firstStats;
+    LoremStats secondStats;
+    string a;
+    string b;
+    layout.render (generator, ranges, first, firstStats, a);
+    layout.render (generator, ranges, second, secondStats, b);
+    if (a.size () > bound)
+        return fail ("template output exceeds its maxBytes");
+    if (a != b)
+        return fail ("template output differs for the same seed");
+    if (!isUtf8 (a) && isUtf8 (source))
+        return fail ("template output is not valid UTF-8");
+    return true;
+}
+
+/**
+* Check many pseudo random requests, biased towards boundary values.
+* @param iterations  the number of requests.
+* @param seed        master seed of the requests themselves.
+* @param failure     receives the failing case and broken property.
+* @return false at the first request that breaks a property.
+*/
+bool LoremCheck::run (unsigned long long iterations, unsigned long long seed, string* failure) {
+    const long interesting = (long) (sizeof (Interesting) / sizeof (Interesting[0]));
+    const long pieces = (long) (sizeof (Pieces) / sizeof (Pieces[0]));
+    const long junk = (long) (sizeof (Junk) / sizeof (Junk[0]));
+    const long words = (long) (sizeof (Words) / sizeof (Words[0]));
+    const long blanks = (long) (sizeof (Blanks) / sizeof (Blanks[0]));
+    Random random (seed);
+    vector<uint8_t> input;
+
+    auto pick = [&] () -> long long {
+        if (random.random_boolean (0, 60))
+            return random.uniform (0, -2, 20);
+        if (random.random_boolean (0, 60))
+            return Interesting[random.uniform (0, 0, interesting - 1)];
+        return random.uniform (0, 0, 120);
+    };
+
+    // Mostly plain numbers, sometimes with blanks or a sign, sometimes not a number at all.
+    auto type = [&] (long long value) {
+        string text = to_string (value);
+        if (random.random_boolean (0, 10))
+            text = Junk[random.uniform (0, 0, junk - 1)];
+        else if (random.random_boolean (0, 10))
+            text = " " + text + "\t";
+        else if (random.random_boolean (0, 5) && value >= 0)
+            text = "+" + text;
+        input.insert (input.end (), text.begin (), text.end ());
+        input.push_back (0);
+    };
+
+    for (unsigned long long i = 0; i < iterations; i++) {
+        long long values[5];
+        values[0] = pick ();
+        values[1] = random.random_boolean (0, 70) ? values[0] + random.uniform (0, -1, 30) : pick ();
+        values[2] = pick ();
+        values[3] = random.random_boolean (0, 70) ? values[2] + random.uniform (0, -1, 30) : pick ();
+        values[4] = pick ();
+
+        input.clear ();
+        put (input, (unsigned long long) random.uniform (0, 0, 1), 1);
+        put (input, ((unsigned long long) random.uniform (0, 0, 0x7FFFFFFF) << 32) | (unsigned long long) random.uniform (0, 0, 0x7FFFFFFF), 8);
+        for (int field = 0; field < 5; field++)
+            type (values[field]);
+        if (random.random_boolean (0, 40))
+            for (long n = random.uniform (0, 1, 8); n > 0; n--) {
+                const char* word = random.random_boolean (0, 85) ? Words[random.uniform (0, 0, words - 1)] : "";
+                const char* blank = Blanks[random.uniform (0, 0, blanks - 1)];
+                input.insert (input.end (), word, word + strlen (word));
+                input.insert (input.end (), blank, blank + strlen (blank));
+            }
+        input.push_back (0);
+        for (long n = random.uniform (0, 0, 6); n > 0; n--) {
+            const char* piece = Pieces[random.uniform (0, 0, pieces - 1)];
+            input.insert (input.end (), piece, piece + strlen (piece));
+        }
+
+        if (!check (input.data (), input.size (), failure)) {
+            if (failure != nullptr)
+                *failure = "case " + to_string (i) + ": " + *failure;
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef LOREM_FUZZ
+/**
+* libFuzzer entry point; abort so the fuzzer keeps the input that broke a property.
+*/
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t* data, size_t size) {
+    string failure;
+    if (!LoremCheck::check (data, size, &failure)) {
+        fprintf (stderr, "%s\n", failure.c_str ());
+        abort ();
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,57 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     LoremCheck.h                                        */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     Property checks over the generator's parameter space: output size     */
+/*     bounds, termination, a memory ceiling and determinism per seed.       */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     check (data, size) decodes arbitrary bytes into a seed, settings      */
+/*     typed as text (parsed like the window and command line do), a         */
+/*     dictionary and a template, so it can be driven by run ()              */
+/*     (--self-check) or, built with LOREM_FUZZ and -fsanitize=fuzzer, by    */
+/*     libFuzzer.  Requests whose bound exceeds MemoryCeiling are only       */
+/*     streamed, up to ProbeBytes.                                           */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _LOREMCHECK_H_
+#define   _LOREMCHECK_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "LoremGenerator.h"
+
+
+class LoremCheck {
+
+public:
+	static constexpr unsigned long long MemoryCeiling = 16ULL * 1024 * 1024;
+	static constexpr unsigned long long ProbeBytes = 256ULL * 1024;
+
+	static bool check (const LoremGenerator& generator, const LoremSettings& settings,
+	                   unsigned long long seed, std::string* failure);
+	static bool check (const uint8_t* data, size_t size, std::string* failure);
+	static bool run (unsigned long long iterations, unsigned long long seed, std::string* failure);
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    LoremCheck.h                                           */
+/*****************************************************************************/
@@ -0,0 +1,415 @@
+/****************************************************************************/
+/* BEGIN FILE LoremCli.cpp                                                  */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*      Generates Lorem Ipsum text without showing the main window.         */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*      The random streams start from their fixed initial state (or from    */
+/*      --seed), so the same arguments always produce the same text.        */
+/*      The generator only holds the dictionary; the request is described   */
+/*      by a local settings, random and stats passed to its const methods.  */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include "LoremCli.h"
+#include "LoremGenerator.h"
+#include "DocumentCache.h"
+#include "CompressedWriter.h"
+#include "LoremTemplate.h"
+#include "BulkWriter.h"
+#include "LoremCheck.h"
+#include "RandomCheck.h"
+
+/****************************************************************************/
+
+using namespace std;
+
+static const size_t ChunkSize = 1024 * 1024;
+static const double StartupBudgetSeconds = 0.001;
+static const int StartupRepeats = 1000;
+static const unsigned long long MaxDocumentBytes = 1024ULL * 1024 * 1024;   // Largest document held in memory
+
+/**
+* Read an integer option, reporting a malformed value.  Parsed as the window parses its fields.
+* @param parser  the parsed command line.
+* @param option  the option to read.
+* @param value   receives the value when the option is present and valid.
+* @return false if the value is not an integer.
+*/
+static bool intOption (const QCommandLineParser& parser, const QCommandLineOption& option, int& value) {
+    if (!parser.isSet (option))
+        return true;
+    if (!LoremGenerator::parseInt (parser.value (option).toStdString (), value)) {
+        cerr << "Invalid value for --" << option.names ().last ().toStdString () << ": "
+             << parser.value (option).toStdString () << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+* Time how long the engine takes to become ready: constructing a generator and its
+* random streams and producing a first paragraph.  The first round is the cold start.
+* @param launched  seconds from entering runCommandLine to the options being parsed.
+* @return the process exit code, 1 if the cold start is over budget.
+*/
+static int startupBenchmark (double launched) {
+    typedef chrono::steady_clock Clock;
+    double cold = 0.0;
+    double total = 0.0;
+    size_t bytes = 0;
+
+    for (int i = 0; i <= StartupRepeats; i++) {
+        const Clock::time_point start = Clock::now ();
+        LoremGenerator generator;
+        LoremSettings settings;
+        Random random;
+        LoremStats stats;
+        bytes += generator.paragraphs (settings, random, stats).size ();
+        const double seconds = chrono::duration<double> (Clock::now () - start).count ();
+        if (i == 0)
+            cold = seconds;
+        else
+            total += seconds;
+    }
+    printf ("launch:       %.1f us\n", launched * 1.0e6);
+    printf ("engine cold:  %.1f us (budget %.0f us)\n", cold * 1.0e6, StartupBudgetSeconds * 1.0e6);
+    printf ("engine warm:  %.2f us mean of %d (%zu bytes)\n", total / StartupRepeats * 1.0e6, StartupRepeats, bytes);
+    return cold <= StartupBudgetSeconds ? 0 : 1;
+}
+
+/**
+* Is the program being run headless?
+*/
+bool isCommandLine (int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp (argv[i], "--cli") == 0)
+            return true;
+    return false;
+}
+
+/**
+* Parse the command line, generate the text and write it to standard output.
+* @return the process exit code.
+*/
+int runCommandLine (int argc, char *argv[]) {
+    typedef chrono::steady_clock Clock;
+    const Clock::time_point started = Clock::now ();
+    QCoreApplication app (argc, argv);
+    QCoreApplication::setApplicationName (QStringLiteral ("LoremIpsum"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription (QStringLiteral ("Lorem Ipsum text generator."));
+    parser.addHelpOption ();
+
+    QCommandLineOption cliOpt (QStringLiteral ("cli"), QStringLiteral ("Run without the main window."));
+    QCommandLineOption paraOpt (QStringList () << QStringLiteral ("p") << QStringLiteral ("paragraphs"),
+                                QStringLiteral ("Number of paragraphs."), QStringLiteral ("count"), QStringLiteral ("1"));
+    QCommandLineOption stdOpt (QStringList () << QStringLiteral ("s") << QStringLiteral ("standard"),
+                               QStringLiteral ("Begin with the standard Lorem Ipsum paragraph."));
+    QCommandLineOption minWdOpt (QStringLiteral ("min-words"), QStringLiteral ("Minimum words per fragment."), QStringLiteral ("count"));
+    QCommandLineOption maxWdOpt (QStringLiteral ("max-words"), QStringLiteral ("Maximum words per fragment."), QStringLiteral ("count"));
+    QCommandLineOption minSentOpt (QStringLiteral ("min-sentences"), QStringLiteral ("Minimum sentences per paragraph."), QStringLiteral ("count"));
+    QCommandLineOption maxSentOpt (QStringLiteral ("max-sentences"), QStringLiteral ("Maximum sentences per paragraph."), QStringLiteral ("count"));
+    QCommandLineOption seedOpt (QStringLiteral ("seed"), QStringLiteral ("Derive the random streams from this seed."), QStringLiteral ("seed"));
+    QCommandLineOption cacheOpt (QStringLiteral ("cache"), QStringLiteral ("Serve repeated requests from the document cache."));
+    QCommandLineOption cacheDirOpt (QStringLiteral ("cache-dir"), QStringLiteral ("Document cache location (implies --cache)."), QStringLiteral ("dir"));
+    QCommandLineOption cacheSizeOpt (QStringLiteral ("cache-size"), QStringLiteral ("Document cache size cap in MB."), QStringLiteral ("MB"));
+    QCommandLineOption outputOpt (QStringList () << QStringLiteral ("o") << QStringLiteral ("output"),
+                                  QStringLiteral ("Write to a file instead of standard output; .gz and .zst names are compressed."), QStringLiteral ("file"));
+    QCommandLineOption charsOpt (QStringLiteral ("characters"), QStringLiteral ("Generate exactly this many characters instead of paragraphs."), QStringLiteral ("count"));
+    QCommandLineOption dictOpt (QStringLiteral ("dictionary"), QStringLiteral ("UTF-8 file of whitespace separated words to use instead of the Latin ones."), QStringLiteral ("file"));
+    QCommandLineOption compressOpt (QStringLiteral ("compress"), QStringLiteral ("Output compression: none, gzip or zstd."), QStringLiteral ("format"));
+    QCommandLineOption templateOpt (QStringLiteral ("template"), QStringLiteral ("Document layout, e.g. \"{title}\\n{para:2-4}\\n{list:3-6}\"."), QStringLiteral ("layout"));
+    QCommandLineOption templateFileOpt (QStringLiteral ("template-file"), QStringLiteral ("Read the document layout from a file."), QStringLiteral ("file"));
+    QCommandLineOption docsOpt (QStringLiteral ("documents"), QStringLiteral ("Number of templated documents."), QStringLiteral ("count"), QStringLiteral ("1"));
+    QCommandLineOption bulkOpt (QStringLiteral ("bulk"), QStringLiteral ("Write this many separate documents into --out-dir."), QStringLiteral ("count"));
+    QCommandLineOption outDirOpt (QStringLiteral ("out-dir"), QStringLiteral ("Directory for --bulk documents."), QStringLiteral ("dir"), QStringLiteral ("."));
+    QCommandLineOption minParaOpt (QStringLiteral ("min-paragraphs"), QStringLiteral ("With --bulk, documents have between this and --paragraphs paragraphs."), QStringLiteral ("count"));
+    QCommandLineOption threadsOpt (QStringLiteral ("threads"), QStringLiteral ("Worker threads for --bulk (default: one per core)."), QStringLiteral ("count"));
+    QCommandLineOption statsOpt (QStringLiteral ("stats"), QStringLiteral ("Report generation statistics on standard error."));
+    QCommandLineOption startupOpt (QStringLiteral ("startup-benchmark"), QStringLiteral ("Time engine startup against its 1 ms budget and exit."));
+    QCommandLineOption checkOpt (QStringLiteral ("self-check"), QStringLiteral ("Check this many random requests against the generator's invariants and exit."), QStringLiteral ("cases"));
+    QCommandLineOption randomCheckOpt (QStringLiteral ("random-check"), QStringLiteral ("Test every random distribution on this many samples, report throughput and exit."), QStringLiteral ("samples"));
+
+    parser.addOptions ({ cliOpt, paraOpt, stdOpt, minWdOpt, maxWdOpt, minSentOpt, maxSentOpt,
+                         seedOpt, cacheOpt, cacheDirOpt, cacheSizeOpt, outputOpt, charsOpt, dictOpt, compressOpt, templateOpt, templateFileOpt, docsOpt, bulkOpt, outDirOpt, minParaOpt, threadsOpt, statsOpt, startupOpt, checkOpt, randomCheckOpt });
+    parser.process (app);
+
+    if (parser.isSet (startupOpt))
+        return startupBenchmark (chrono::duration<double> (Clock::now () - started).count ());
+
+    // Without --seed the checks start from seed 1 and generation from the fixed initial state.
+    qulonglong seed = 1;
+    if (parser.isSet (seedOpt)) {
+        bool ok = false;
+        seed = parser.value (seedOpt).toULongLong (&ok);
+        if (!ok) {
+            cerr << "Invalid value for --seed: " << parser.value (seedOpt).toStdString () << endl;
+            return 1;
+        }
+    }
+
+    if (parser.isSet (checkOpt)) {
+        bool valid = false;
+        const qulonglong cases = parser.value (checkOpt).toULongLong (&valid);
+        if (!valid) {
+            cerr << "Invalid value for --self-check: " << parser.value (checkOpt).toStdString () << endl;
+            return 1;
+        }
+        string failure;
+        if (!LoremCheck::run (cases, seed, &failure)) {
+            cerr << "Self check failed, " << failure << endl;
+            return 1;
+        }
+        cout << cases << " cases passed" << endl;
+        return 0;
+    }
+
+    if (parser.isSet (randomCheckOpt)) {
+        bool valid = false;
+        const qulonglong samples = parser.value (randomCheckOpt).toULongLong (&valid);
+        if (!valid) {
+            cerr << "Invalid value for --random-check: " << parser.value (randomCheckOpt).toStdString () << endl;
+            return 1;
+        }
+        string report;
+        const bool passed = RandomCheck::run (samples, seed, report);
+        cout << report;
+        if (!passed) {
+            cerr << "Random check failed." << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    LoremGenerator generator;
+    LoremSettings settings;
+    Random random;
+    LoremStats stats;
+    int documents = 1;
+    int cacheMB = (int) (DocumentCache::DefaultMaxBytes / (1024 * 1024));
+
+    settings.useStandard = parser.isSet (stdOpt);
+    if (!intOption (parser, paraOpt, settings.paragraphCount) ||
+        !intOption (parser, minWdOpt, settings.minWordCount) ||
+        !intOption (parser, maxWdOpt, settings.maxWordCount) ||
+        !intOption (parser, minSentOpt, settings.minSentenceCount) ||
+        !intOption (parser, maxSentOpt, settings.maxSentenceCount) ||
+        !intOption (parser, cacheSizeOpt, cacheMB) ||
+        !intOption (parser, docsOpt, documents))
+        return 1;
+    string invalid;
+    if (!LoremGenerator::validate (settings, &invalid)) {
+        cerr << "Invalid settings, " << invalid << endl;
+        return 1;
+    }
+
+    if (parser.isSet (seedOpt))
+        random.set_seed (seed);
+
+    if (parser.isSet (dictOpt)) {
+        QFile file (parser.value (dictOpt));
+        if (!file.open (QIODevice::ReadOnly)) {
+            cerr << "Cannot open " << parser.value (dictOpt).toStdString () << endl;
+            return 1;
+        }
+        if (!generator.setDictionary (file.readAll ().toStdString ())) {
+            cerr << "No words in " << parser.value (dictOpt).toStdString () << endl;
+            return 1;
+        }
+    }
+
+    LoremTemplate layout;
+    if (parser.isSet (templateOpt) || parser.isSet (templateFileOpt)) {
+        string source = parser.value (templateOpt).toStdString ();
+        if (parser.isSet (templateFileOpt)) {
+            QFile file (parser.value (templateFileOpt));
+            if (!file.open (QIODevice::ReadOnly)) {
+                cerr << "Cannot open " << parser.value (templateFileOpt).toStdString () << endl;
+                return 1;
+            }
+            source = file.readAll ().toStdString ();
+        }
+        string error;
+        if (!layout.compile (source, &error)) {
+            cerr << "Invalid template, " << error << endl;
+            return 1;
+        }
+        if (layout.maxBytes (generator, settings) > MaxDocumentBytes) {
+            cerr << "Invalid template, a document could exceed " << MaxDocumentBytes << " bytes" << endl;
+            return 1;
+        }
+    }
+
+    if (parser.isSet (bulkOpt)) {
+        BulkOptions bulk;
+        bool valid = false;
+        bulk.count = parser.value (bulkOpt).toULongLong (&valid);
+        if (!valid) {
+            cerr << "Invalid value for --bulk: " << parser.value (bulkOpt).toStdString () << endl;
+            return 1;
+        }
+        bulk.maxParagraphs = settings.paragraphCount;
+        bulk.minParagraphs = settings.paragraphCount;
+        if (!intOption (parser, minParaOpt, bulk.minParagraphs) || !intOption (parser, threadsOpt, bulk.threads))
+            return 1;
+        if (bulk.minParagraphs < 0) {
+            cerr << "Invalid value for --min-paragraphs: " << bulk.minParagraphs << endl;
+            return 1;
+        }
+        if (bulk.minParagraphs > bulk.maxParagraphs)
+            bulk.maxParagraphs = bulk.minParagraphs;
+        LoremSettings largest = settings;
+        largest.paragraphCount = bulk.maxParagraphs;
+        if (generator.maxBytes (largest) > MaxDocumentBytes) {
+            cerr << "Bulk documents could exceed " << MaxDocumentBytes << " bytes; lower --paragraphs" << endl;
+            return 1;
+        }
+        bulk.seed = parser.isSet (seedOpt) ? seed : 0;
+        bulk.settings = settings;
+        bulk.generator = &generator;
+        if (!layout.isEmpty ())
+            bulk.layout = &layout;
+
+        const QString dir = parser.value (outDirOpt);
+        if (!QDir ().mkpath (dir)) {
+            cerr << "Cannot create " << dir.toStdString () << endl;
+            return 1;
+        }
+        bulk.directory = dir.toStdString ();
+
+        const BulkProgress done = BulkWriter::run (bulk, [] (const BulkProgress& p) {
+            const double seconds = p.seconds > 0.0 ? p.seconds : 1.0;
+            fprintf (stderr, "\r%llu files  %.0f files/s  %.1f MB/s", p.files, p.files / seconds, p.bytes / seconds / 1.0e6);
+        });
+        fprintf (stderr, "\n");
+        if (done.failures > 0) {
+            cerr << done.failures << " documents could not be written." << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Text goes either straight to standard output or through the compression pipeline.
+    unique_ptr<CompressedWriter> writer;
+    const string path = parser.value (outputOpt).toStdString ();
+    CompressedWriter::Format format = parser.isSet (outputOpt) ? CompressedWriter::formatFor (path) : CompressedWriter::Plain;
+    if (parser.isSet (compressOpt)) {
+        const QString name = parser.value (compressOpt);
+        if (name == QStringLiteral ("none"))
+            format = CompressedWriter::Plain;
+        else if (name == QStringLiteral ("gzip"))
+            format = CompressedWriter::Gzip;
+        else if (name == QStringLiteral ("zstd"))
+            format = CompressedWriter::Zstd;
+        else {
+            cerr << "Invalid value for --compress: " << name.toStdString () << endl;
+            return 1;
+        }
+    }
+    if (!CompressedWriter::isAvailable (format)) {
+        cerr << "This build has no " << (format == CompressedWriter::Gzip ? "gzip" : "zstd") << " support." << endl;
+        return 1;
+    }
+    if (parser.isSet (outputOpt))
+        writer.reset (new CompressedWriter (path, format));
+    else if (format != CompressedWriter::Plain)
+        writer.reset (new CompressedWriter (stdout, format));
+    if (writer && !writer->isOpen ()) {
+        cerr << "Cannot open " << (parser.isSet (outputOpt) ? path : string ("standard output")) << endl;
+        return 1;
+    }
+    auto sink = [&writer] (string&& chunk) {
+        if (writer)
+            return writer->write (std::move (chunk));
+        return fwrite (chunk.data (), 1, chunk.size (), stdout) == chunk.size ();
+    };
+    auto sinkView = [&writer] (string_view text) {
+        if (writer)
+            return writer->write (string (text));
+        return fwrite (text.data (), 1, text.size (), stdout) == text.size ();
+    };
+
+    const Clock::time_point generating = Clock::now ();
+    string cacheResult;
+    bool ok;
+    if (!layout.isEmpty ()) {
+        string s;
+        ok = true;
+        for (int i = 0; ok && i < documents; i++) {
+            layout.render (generator, settings, random, stats, s);
+            s.append ("\n");
+            if (s.size () >= ChunkSize || i == documents - 1) {
+                ok = sink (std::move (s));
+                s = string ();
+            }
+        }
+    } else if (parser.isSet (charsOpt)) {
+        bool valid = false;
+        const qulonglong chars = parser.value (charsOpt).toULongLong (&valid);
+        if (!valid || chars > MaxDocumentBytes / 4) {
+            cerr << "Invalid value for --characters: " << parser.value (charsOpt).toStdString () << endl;
+            return 1;
+        }
+        ok = sink (generator.characters ((size_t) chars, settings, random, stats));
+    } else if ((parser.isSet (cacheOpt) || parser.isSet (cacheDirOpt)) &&
+               generator.maxBytes (settings) > (unsigned long long) cacheMB * 1024 * 1024) {
+        // Could not be cached anyway, and cached documents are built in memory: stream it instead.
+        cacheResult = "bypassed, the document could exceed the cache size";
+        ok = generator.paragraphs (settings, random, stats, ChunkSize, sink);
+    } else if (parser.isSet (cacheOpt) || parser.isSet (cacheDirOpt)) {
+        DocumentCache cache (parser.value (cacheDirOpt), (qint64) cacheMB * 1024 * 1024);
+        const Clock::time_point lookup = Clock::now ();
+        ok = cache.paragraphs (generator, settings, random, stats, sinkView);
+        cacheResult = (cache.hits () > 0 ? "hit in " : "miss in ")
+                    + to_string (chrono::duration<double> (Clock::now () - lookup).count ()) + " s";
+    } else {
+        ok = generator.paragraphs (settings, random, stats, ChunkSize, sink);
+    }
+
+    const Clock::time_point finishing = Clock::now ();
+    if (writer)
+        ok = writer->close () && ok;
+    else
+        ok = fflush (stdout) == 0 && ok;
+
+    if (parser.isSet (statsOpt)) {
+        auto since = [] (Clock::time_point t0, Clock::time_point t1) {
+            return to_string (chrono::duration<double> (t1 - t0).count ()) + " s";
+        };
+        const Clock::time_point finished = Clock::now ();
+        cerr << LoremGenerator::statsReport (stats, settings, random);
+        if (!cacheResult.empty ())
+            cerr << "cache:        " << cacheResult << "\n";
+        if (writer)
+            cerr << "compressed:   " << writer->bytesIn () << " -> " << writer->bytesOut () << " bytes\n";
+        cerr << "startup:      " << since (started, generating) << "\n"
+             << "finish:       " << since (finishing, finished) << "\n"
+             << "total:        " << since (started, finished) << endl;
+    }
+    if (!ok) {
+        cerr << "Error writing output." << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+/****************************************************************************/
+/* BEGIN FILE  LoremCli.h                                                   */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*      Headless (command line) front end for scripts and pipelines.        */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*      Selected from main() when "--cli" is among the arguments.           */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* SAFETY DEFINITION                                                        */
+/*                                                                          */
+
+#ifndef LOREMCLI_H
+#define LOREMCLI_H
+
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#pragma once
+
+/****************************************************************************/
+/*	 Begin Code                                                             */
+
+bool isCommandLine (int argc, char *argv[]);
+int runCommandLine (int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,894 @@
+/****************************************************************************/
+/* BEGIN FILE             LoremGenerator.cpp                                */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        The GUI independent Lorem Ipsum text engine.                      */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        Some code based on Java code by Oliver Dodd                       */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*      @author    jsowers             09JUN24                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include "LoremGenerator.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */ 
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/**
+* Widen an observed [lo, hi] range (empty while lo > hi) to include a value.
+*/
+static inline void observe (int& lo, int& hi, int value) {
+    if (lo > hi)
+        lo = hi = value;
+    else if (value < lo)
+        lo = value;
+    else if (value > hi)
+        hi = value;
+}
+
+/**
+* Seconds elapsed since a start time.
+*/
+static inline double secondsSince (Clock::time_point start) {
+    return chrono::duration<double> (Clock::now () - start).count ();
+}
+
+/**
+* Bytes in the UTF-8 sequence introduced by a lead byte (1 for stray bytes).
+*/
+static inline size_t utf8SequenceLength (unsigned char lead) {
+    return lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+}
+
+/**
+* Is the UTF-8 sequence of len bytes at text[pos] white space?
+* ASCII blanks and the Unicode space separators, as \s matches in QRegularExpression.
+*/
+static bool isSpace (const string& text, size_t pos, size_t len) {
+    const unsigned char* c = (const unsigned char*) text.data () + pos;
+    if (len == 1)
+        return c[0] == ' ' || (c[0] >= '\t' && c[0] <= '\r');
+    if (len == 2)
+        return c[0] == 0xC2 && (c[1] == 0x85 || c[1] == 0xA0);
+    if (len != 3)
+        return false;
+    const unsigned long u = ((c[0] & 0x0FUL) << 12) | ((c[1] & 0x3FUL) << 6) | (c[2] & 0x3FUL);
+    return u == 0x1680 || (u >= 0x2000 && u <= 0x200A) || u == 0x2028 || u == 0x2029 ||
+           u == 0x202F || u == 0x205F || u == 0x3000;
+}
+
+/**
+* Copy UTF-8 text, replacing every malformed sequence (stray continuation bytes,
+* truncated or overlong sequences, surrogates, code points past U+10FFFF) with U+FFFD,
+* the way QString::fromUtf8 does.
+*/
+static string repairUtf8 (const string& text) {
+    string s;
+    s.reserve (text.size ());
+    for (size_t i = 0; i < text.size (); ) {
+        const unsigned char lead = (unsigned char) text[i];
+        size_t len = utf8SequenceLength (lead);
+        bool valid = lead < 0x80 || (lead >= 0xC2 && lead <= 0xF4);
+        for (size_t k = 1; valid && k < len; k++)
+            valid = i + k < text.size () && ((unsigned char) text[i + k] & 0xC0) == 0x80;
+        if (valid && len > 2) {
+            const unsigned char next = (unsigned char) text[i + 1];
+            valid = !(lead == 0xE0 && next < 0xA0) && !(lead == 0xED && next >= 0xA0) &&
+                    !(lead == 0xF0 && next < 0x90) && !(lead == 0xF4 && next >= 0x90);
+        }
+        if (valid) {
+            s.append (text, i, len);
+        } else {
+            s.append ("\xEF\xBF\xBD");
+            len = 1;
+        }
+        i += len;
+    }
+    return s;
+}
+
+/**
+* The built in Latin dictionary, with case forms and lengths worked out in
+* advance so that it needs no initialization at run time.
+*/
+static constexpr LoremWord Latin[] = {
+    { "a", "A", 1 }, { "ac", "Ac", 2 }, { "accumsan", "Accumsan", 8 }, { "ad", "Ad", 2 },
+    { "adipiscing", "Adipiscing", 10 }, { "aenean", "Aenean", 6 }, { "aliquam", "Aliquam", 7 },
+    { "aliquet", "Aliquet", 7 }, { "amet", "Amet", 4 }, { "ante", "Ante", 4 }, { "aptent", "Aptent", 6 },
+    { "arcu", "Arcu", 4 }, { "at", "At", 2 }, { "auctor", "Auctor", 6 }, { "augue", "Augue", 5 },
+    { "bibendum", "Bibendum", 8 }, { "blandit", "Blandit", 7 }, { "class", "Class", 5 }, { "commodo", "Commodo", 7 },
+    { "condimentum", "Condimentum", 11 }, { "congue", "Congue", 6 }, { "consectetur", "Consectetur", 11 },
+    { "consequat", "Consequat", 9 }, { "conubia", "Conubia", 7 }, { "convallis", "Convallis", 9 },
+    { "cras", "Cras", 4 }, { "cubilia", "Cubilia", 7 }, { "cum", "Cum", 3 }, { "curabitur", "Curabitur", 9 },
+    { "curae", "Curae", 5 }, { "cursus", "Cursus", 6 }, { "dapibus", "Dapibus", 7 }, { "diam", "Diam", 4 },
+    { "dictum", "Dictum", 6 }, { "dictumst", "Dictumst", 8 }, { "dignissim", "Dignissim", 9 }, { "dis", "Dis", 3 },
+    { "dolor", "Dolor", 5 }, { "donec", "Donec", 5 }, { "dui", "Dui", 3 }, { "duis", "Duis", 4 },
+    { "egestas", "Egestas", 7 }, { "eget", "Eget", 4 }, { "eleifend", "Eleifend", 8 },
+    { "elementum", "Elementum", 9 }, { "elit", "Elit", 4 }, { "enim", "Enim", 4 }, { "erat", "Erat", 4 },
+    { "eros", "Eros", 4 }, { "est", "Est", 3 }, { "et", "Et", 2 }, { "etiam", "Etiam", 5 }, { "eu", "Eu", 2 },
+    { "euismod", "Euismod", 7 }, { "facilisi", "Facilisi", 8 }, { "facilisis", "Facilisis", 9 },
+    { "fames", "Fames", 5 }, { "faucibus", "Faucibus", 8 }, { "felis", "Felis", 5 }, { "fermentum", "Fermentum", 9 },
+    { "feugiat", "Feugiat", 7 }, { "fringilla", "Fringilla", 9 }, { "fusce", "Fusce", 5 },
+    { "gravida", "Gravida", 7 }, { "habitant", "Habitant", 8 }, { "habitasse", "Habitasse", 9 }, { "hac", "Hac", 3 },
+    { "hendrerit", "Hendrerit", 9 }, { "himenaeos", "Himenaeos", 9 }, { "iaculis", "Iaculis", 7 }, { "id", "Id", 2 },
+    { "imperdiet", "Imperdiet", 9 }, { "in", "In", 2 }, { "inceptos", "Inceptos", 8 }, { "integer", "Integer", 7 },
+    { "interdum", "Interdum", 8 }, { "ipsum", "Ipsum", 5 }, { "justo", "Justo", 5 }, { "lacinia", "Lacinia", 7 },
+    { "lacus", "Lacus", 5 }, { "laoreet", "Laoreet", 7 }, { "lectus", "Lectus", 6 }, { "leo", "Leo", 3 },
+    { "libero", "Libero", 6 }, { "ligula", "Ligula", 6 }, { "litora", "Litora", 6 }, { "lobortis", "Lobortis", 8 },
+    { "lorem", "Lorem", 5 }, { "luctus", "Luctus", 6 }, { "maecenas", "Maecenas", 8 }, { "magna", "Magna", 5 },
+    { "magnis", "Magnis", 6 }, { "malesuada", "Malesuada", 9 }, { "massa", "Massa", 5 }, { "mattis", "Mattis", 6 },
+    { "mauris", "Mauris", 6 }, { "metus", "Metus", 5 }, { "mi", "Mi", 2 }, { "molestie", "Molestie", 8 },
+    { "mollis", "Mollis", 6 }, { "montes", "Montes", 6 }, { "morbi", "Morbi", 5 }, { "mus", "Mus", 3 },
+    { "nam", "Nam", 3 }, { "nascetur", "Nascetur", 8 }, { "natoque", "Natoque", 7 }, { "nec", "Nec", 3 },
+    { "neque", "Neque", 5 }, { "netus", "Netus", 5 }, { "nibh", "Nibh", 4 }, { "nisi", "Nisi", 4 },
+    { "nisl", "Nisl", 4 }, { "non", "Non", 3 }, { "nostra", "Nostra", 6 }, { "nulla", "Nulla", 5 },
+    { "nullam", "Nullam", 6 }, { "nunc", "Nunc", 4 }, { "odio", "Odio", 4 }, { "orci", "Orci", 4 },
+    { "ornare", "Ornare", 6 }, { "parturient", "Parturient", 10 }, { "pellentesque", "Pellentesque", 12 },
+    { "penatibus", "Penatibus", 9 }, { "per", "Per", 3 }, { "pharetra", "Pharetra", 8 },
+    { "phasellus", "Phasellus", 9 }, { "placerat", "Placerat", 8 }, { "platea", "Platea", 6 },
+    { "porta", "Porta", 5 }, { "porttitor", "Porttitor", 9 }, { "posuere", "Posuere", 7 },
+    { "potenti", "Potenti", 7 }, { "praesent", "Praesent", 8 }, { "pretium", "Pretium", 7 },
+    { "primis", "Primis", 6 }, { "proin", "Proin", 5 }, { "pulvinar", "Pulvinar", 8 }, { "purus", "Purus", 5 },
+    { "quam", "Quam", 4 }, { "quis", "Quis", 4 }, { "quisque", "Quisque", 7 }, { "rhoncus", "Rhoncus", 7 },
+    { "ridiculus", "Ridiculus", 9 }, { "risus", "Risus", 5 }, { "rutrum", "Rutrum", 6 },
+    { "sagittis", "Sagittis", 8 }, { "sapien", "Sapien", 6 }, { "scelerisque", "Scelerisque", 11 },
+    { "sed", "Sed", 3 }, { "sem", "Sem", 3 }, { "semper", "Semper", 6 }, { "senectus", "Senectus", 8 },
+    { "sit", "Sit", 3 }, { "sociis", "Sociis", 6 }, { "sociosqu", "Sociosqu", 8 }, { "sodales", "Sodales", 7 },
+    { "sollicitudin", "Sollicitudin", 12 }, { "suscipit", "Suscipit", 8 }, { "suspendisse", "Suspendisse", 11 },
+    { "taciti", "Taciti", 6 }, { "tellus", "Tellus", 6 }, { "tempor", "Tempor", 6 }, { "tempus", "Tempus", 6 },
+    { "tincidunt", "Tincidunt", 9 }, { "torquent", "Torquent", 8 }, { "tortor", "Tortor", 6 },
+    { "tristique", "Tristique", 9 }, { "turpis", "Turpis", 6 }, { "ullamcorper", "Ullamcorper", 11 },
+    { "ultrices", "Ultrices", 8 }, { "ultricies", "Ultricies", 9 }, { "urna", "Urna", 4 }, { "ut", "Ut", 2 },
+    { "varius", "Varius", 6 }, { "vehicula", "Vehicula", 8 }, { "vel", "Vel", 3 }, { "velit", "Velit", 5 },
+    { "venenatis", "Venenatis", 9 }, { "vestibulum", "Vestibulum", 10 }, { "vitae", "Vitae", 5 },
+    { "vivamus", "Vivamus", 7 }, { "viverra", "Viverra", 7 }, { "volutpat", "Volutpat", 8 },
+    { "vulputate", "Vulputate", 9 }
+};
+
+static constexpr size_t NumberOfWords = sizeof (Latin) / sizeof (Latin[0]);
+
+/**
+* Bytes in the longest form of any word of a dictionary.
+*/
+static constexpr size_t longestWord (const LoremWord* words, size_t count) {
+    size_t longest = 0;
+    for (size_t i = 0; i < count; i++) {
+        longest = words[i].text.size () > longest ? words[i].text.size () : longest;
+        longest = words[i].capitalized.size () > longest ? words[i].capitalized.size () : longest;
+    }
+    return longest;
+}
+
+/****************************************************************************/
+
+/**
+* Default Constructor.  Uses the built in dictionary, so allocates nothing.
+*/
+LoremGenerator::LoremGenerator () : entries (Latin), entryCount (NumberOfWords),
+                                    longestEntry (longestWord (Latin, NumberOfWords)) {
+}
+
+/**
+* Default Destructor.
+*/
+LoremGenerator::~LoremGenerator () {
+    // Null
+}
+
+/**
+* Replace the word list, e.g. with a non-Latin one.  Words should be UTF-8; malformed
+* sequences are replaced with U+FFFD so that every byte count agrees with the character count.
+* @param words  the new dictionary; empty strings are ignored.
+* @return false (leaving the dictionary unchanged) if no words remain.
+*/
+bool LoremGenerator::setDictionary (const vector<string>& words) {
+    // All the text goes in one buffer; the views are taken once it stops growing,
+    // so until then only the byte lengths of each word and its capitalized form are kept.
+    string text;
+    vector<pair<size_t, size_t>> lengths;
+    vector<LoremWord> loaded;
+    for (const string& word : words)
+        if (!word.empty ()) {
+            const string w = repairUtf8 (word);
+            const string capitalized = capitalize (w);
+            lengths.emplace_back (w.size (), capitalized.size ());
+            loaded.push_back (LoremWord { string_view (), string_view (), characterCount (w) });
+            text.append (w).append (capitalized);
+        }
+    if (loaded.empty ())
+        return false;
+
+    // Swap before taking views: a short string keeps its text inside the object.
+    customText.swap (text);
+    size_t pos = 0;
+    for (size_t i = 0; i < loaded.size (); i++) {
+        loaded[i].text = string_view (customText.data () + pos, lengths[i].first);
+        pos += lengths[i].first;
+        loaded[i].capitalized = string_view (customText.data () + pos, lengths[i].second);
+        pos += lengths[i].second;
+    }
+    customEntries.swap (loaded);
+    entries = customEntries.data ();
+    entryCount = customEntries.size ();
+    longestEntry = longestWord (entries, entryCount);
+    return true;
+}
+
+/**
+* Replace the word list with the words of a text, e.g. the contents of a file.
+* Words are separated by ASCII or Unicode white space.
+* @param text  UTF-8 text; malformed sequences are replaced with U+FFFD.
+* @return false (leaving the dictionary unchanged) if the text holds no words.
+*/
+bool LoremGenerator::setDictionary (const string& text) {
+    vector<string> words (1);
+    for (size_t i = 0; i < text.size (); ) {
+        size_t len = min (utf8SequenceLength ((unsigned char) text[i]), text.size () - i);
+        for (size_t k = 1; k < len; k++)
+            if (((unsigned char) text[i + k] & 0xC0) != 0x80)
+                len = 1;    // Malformed: only the lead byte, so a blank after it still separates
+        if (isSpace (text, i, len)) {
+            if (!words.back ().empty ())
+                words.push_back (string ());
+        } else {
+            words.back ().append (text, i, len);
+        }
+        i += len;
+    }
+    return setDictionary (words);
+}
+
+/**
+* Get a random word.
+*/
+string LoremGenerator::randomWord () {
+    Session session { settings, random, counters, 0 };
+    return string (randomEntry (session).text);
+}
+
+/**
+* Get a random punctuation mark.
+*/
+string LoremGenerator::randomPunctuation () {
+    int randInt = random.uniform (1, 0, 1);
+    return string (punctuation[randInt]);
+}
+
+/**
+* Get a string of words.
+* @param count is the number of words to fetch.
+*/
+string LoremGenerator::wordString (int count) {
+    Session session { settings, random, counters, 0 };
+    string s;
+    appendWords (s, count, session);
+    counters.bytes += s.size ();
+    return s;
+}
+
+/**
+ * Get a sentence fragment.
+ * @param mincount  the smallest number of possible words.
+ * @param maxcount  the largest number of possible words.
+ */
+string LoremGenerator::sentenceFragment (int mincount, int maxcount) {
+    Session session { settings, random, counters, 0 };
+    string s;
+    appendFragment (s, mincount, maxcount, session);
+    counters.bytes += s.size ();
+    return s;
+}
+
+/**
+ * Get a sentence fragment use the input fields to determine the parameters.
+ */
+string LoremGenerator::sentenceFragment () {
+    return sentenceFragment (settings.minWordCount, settings.maxWordCount);
+}
+
+/**
+ * Get a sentence.
+ */
+string LoremGenerator::sentence () {
+    Session session { settings, random, counters, 0 };
+    string s;
+    appendSentence (s, session);
+    counters.bytes += s.size ();
+    return s;
+}
+
+/**
+* Get multiple sentences.
+* @param count - the number of sentences
+*/
+string LoremGenerator::sentences (int count) {
+    Session session { settings, random, counters, 0 };
+    string s = "";
+    while (count-- > 0) {
+        appendSentence (s, session);
+        s.append ("  ");
+    }
+    counters.bytes += s.size ();
+    return s;
+}
+
+/**
+ * Get a paragraph.
+ * @useStandard - get the standard Lorem Ipsum paragraph?
+ * @param minsent the minimum number of sentences
+ * @param maxsent the maximum number of sentences
+ */
+string LoremGenerator::paragraph (bool useStandard, int minsent, int maxsent) {
+    Session session { settings, random, counters, 0 };
+    string s;
+    appendParagraph (s, useStandard, minsent, maxsent, session);
+    counters.bytes += s.size ();
+    return s;
+}
+
+/**
+ * Get a paragraph.
+ * Use the input fields to determine the parameters.
+ * @useStandard - get the standard Lorem Ipsum paragraph?
+ */
+string LoremGenerator::paragraph (bool useStandard) {
+    return paragraph (useStandard, settings.minSentenceCount, settings.maxSentenceCount);
+}
+
+
+/**
+ * Get a standard paragraph.
+ * Get the standard Lorem Ipsum paragraph.
+ */
+string LoremGenerator::paragraph () {
+    return paragraph (false, 1, 1);
+}
+
+/**
+ * Get multiple paragraphs.
+ * @param count is the number of paragraphs
+ * @useStandard - begin with the standard Lorem Ipsum paragraph if true.
+ */
+string LoremGenerator::paragraphs (int count, bool useStandard) {
+    string s = "";
+    appendParagraphs (s, count, useStandard);
+    return s;
+}
+
+/**
+ * Get multiple paragraphs.
+ */
+string LoremGenerator::paragraphs (int count) {
+    return paragraphs (count, false);
+}
+
+/**
+ * Append multiple paragraphs to a buffer, reusing whatever capacity it already has.
+ * @param s is the buffer
+ * @param count is the number of paragraphs
+ * @useStandard - begin with the standard Lorem Ipsum paragraph if true.
+ */
+void LoremGenerator::appendParagraphs (string& s, int count, bool useStandard) {
+    LoremSettings request = settings;
+    request.paragraphCount = count;
+    request.useStandard = useStandard;
+    appendParagraphs (s, request, random, counters);
+}
+
+/**
+ * Stream multiple paragraphs in chunks instead of building one string.
+ * @param count is the number of paragraphs
+ * @useStandard - begin with the standard Lorem Ipsum paragraph if true.
+ * @param chunkSize  a chunk is handed over once it holds at least this many bytes.
+ * @param sink  receives each chunk; returning false stops generation.
+ * @return false if the sink stopped generation.
+ */
+bool LoremGenerator::paragraphs (int count, bool useStandard, size_t chunkSize, const function<bool (string&&)>& sink) {
+    LoremSettings request = settings;
+    request.paragraphCount = count;
+    request.useStandard = useStandard;
+    return paragraphs (request, random, counters, chunkSize, sink);
+}
+
+/**
+ * Get text of exactly count characters (not bytes), cut wherever the count runs out.
+ * @param count  the number of UTF-8 characters wanted.
+ */
+string LoremGenerator::characters (size_t count) {
+    return characters (count, settings, random, counters);
+}
+
+/**
+ * Describe everything that determines the output of paragraphs (count, useStandard).
+ * @param count is the number of paragraphs
+ * @useStandard - begin with the standard Lorem Ipsum paragraph if true.
+ */
+string LoremGenerator::fingerprint (int count, bool useStandard) const {
+    LoremSettings request = settings;
+    request.paragraphCount = count;
+    request.useStandard = useStandard;
+    return fingerprint (request, random);
+}
+
+/**
+ * Zero the generation counters, including the random stream draw counts.
+ */
+void LoremGenerator::resetStats () {
+    counters = LoremStats ();
+    random.reset_draws ();
+}
+
+/**
+ * Describe the counters, one item per line, for logs and the command line.
+ */
+string LoremGenerator::statsReport () const {
+    return statsReport (counters, settings, random);
+}
+
+/**
+ * Append settings.paragraphCount paragraphs to a buffer, reusing whatever capacity it already has.
+ * Safe to call concurrently with other const methods.
+ * @param s is the buffer
+ * @param settings  what to generate; only the first paragraph is standard if useStandard is set.
+ * @param random    the random streams of this request.
+ * @param stats     the counters of this request.
+ */
+void LoremGenerator::appendParagraphs (string& s, const LoremSettings& settings, Random& random, LoremStats& stats) const {
+    const Clock::time_point start = Clock::now ();
+    Session session { settings, random, stats, 0 };
+    const size_t begin = s.size ();
+    size_t capacity = s.capacity ();
+    bool useStandard = settings.useStandard;
+    for (int count = settings.paragraphCount; count > 0; count--) {
+        appendParagraph (s, useStandard, settings.minSentenceCount, settings.maxSentenceCount, session);
+        s.append (line_separator).append (line_separator);
+        useStandard = false;  // Only the 1st paragraph is standard
+        if (s.capacity () != capacity) {
+            stats.allocations++;
+            capacity = s.capacity ();
+        }
+    }
+    stats.bytes += s.size () - begin;
+    stats.generateSeconds += secondsSince (start);
+}
+
+/**
+ * Get settings.paragraphCount paragraphs.  Safe to call concurrently with other const methods.
+ * @param settings  what to generate.
+ * @param random    the random streams of this request.
+ * @param stats     the counters of this request.
+ */
+string LoremGenerator::paragraphs (const LoremSettings& settings, Random& random, LoremStats& stats) const {
+    string s;
+    appendParagraphs (s, settings, random, stats);
+    return s;
+}
+
+/**
+ * Stream settings.paragraphCount paragraphs in chunks instead of building one string,
+ * so arbitrarily large documents can be written out while they are generated.
+ * Produces exactly the text paragraphs (settings, random, stats) would.
+ * @param settings  what to generate.
+ * @param random    the random streams of this request.
+ * @param stats     the counters of this request.
+ * @param chunkSize  a chunk is handed over once it holds at least this many bytes.
+ * @param sink  receives each chunk; returning false stops generation.
+ * @return false if the sink stopped generation.
+ */
+bool LoremGenerator::paragraphs (const LoremSettings& settings, Random& random, LoremStats& stats,
+                                 size_t chunkSize, const function<bool (string&&)>& sink) const {
+    Clock::time_point start = Clock::now ();
+    Session session { settings, random, stats, 0 };
+    string s;
+    s.reserve (chunkSize + standard.size ());
+    stats.allocations++;
+    bool useStandard = settings.useStandard;
+    for (int count = settings.paragraphCount; count > 0; count--) {
+        appendParagraph (s, useStandard, settings.minSentenceCount, settings.maxSentenceCount, session);
+        s.append (line_separator).append (line_separator);
+        useStandard = false;  // Only the 1st paragraph is standard
+        if (s.size () >= chunkSize) {
+            stats.bytes += s.size ();
+            stats.generateSeconds += secondsSince (start);
+            start = Clock::now ();
+            if (!sink (std::move (s)))
+                return false;
+            stats.outputSeconds += secondsSince (start);
+            start = Clock::now ();
+            s = string ();
+            s.reserve (chunkSize + standard.size ());
+            stats.allocations++;
+        }
+    }
+    stats.bytes += s.size ();
+    stats.generateSeconds += secondsSince (start);
+    if (s.empty ())
+        return true;
+    start = Clock::now ();
+    const bool ok = sink (std::move (s));
+    stats.outputSeconds += secondsSince (start);
+    return ok;
+}
+
+/**
+ * Get text of exactly count characters (not bytes), cut wherever the count runs out.
+ * Safe to call concurrently with other const methods.
+ * @param count     the number of UTF-8 characters wanted.
+ * @param settings  word and sentence ranges; the paragraph fields are ignored.
+ * @param random    the random streams of this request.
+ * @param stats     the counters of this request.
+ */
+string LoremGenerator::characters (size_t count, const LoremSettings& settings, Random& random, LoremStats& stats) const {
+    const Clock::time_point start = Clock::now ();
+    Session session { settings, random, stats, 0 };
+    string s;
+    size_t capacity = s.capacity ();
+    size_t mark = 0;
+    size_t markCharacters = 0;
+
+    while (session.characters < count) {
+        mark = s.size ();
+        markCharacters = session.characters;
+        appendSentence (s, session);
+        s.append ("  ");
+        session.characters += 2;
+        if (s.capacity () != capacity) {
+            stats.allocations++;
+            capacity = s.capacity ();
+        }
+    }
+
+    // Only the last sentence needs walking to find where the count ends.  A character
+    // starts at every byte that is not a continuation byte, as in characterCount.
+    size_t pos = mark;
+    for (size_t c = markCharacters; c < count && pos < s.size (); c++)
+        do
+            pos++;
+        while (pos < s.size () && ((unsigned char) s[pos] & 0xC0) == 0x80);
+    s.resize (pos);
+    stats.bytes += s.size ();
+    stats.generateSeconds += secondsSince (start);
+    return s;
+}
+
+/**
+ * Describe everything that determines the output of paragraphs (settings, random, ...):
+ * the engine version, the current state of every random stream, the settings and the
+ * dictionary with its case forms.
+ * Two equal fingerprints always produce the same text.
+ * @param settings  what would be generated.
+ * @param random    the random streams it would be generated from.
+ */
+string LoremGenerator::fingerprint (const LoremSettings& settings, const Random& random) const {
+    seed_array state;
+    random.get_state (state);
+
+    const int fields[] = { EngineVersion, settings.minWordCount, settings.maxWordCount, settings.minSentenceCount,
+                           settings.maxSentenceCount, settings.paragraphCount, settings.useStandard ? 1 : 0 };
+    string s (reinterpret_cast<const char*> (state), sizeof (state));
+    s.append (reinterpret_cast<const char*> (fields), sizeof (fields));
+    s.append (standard).push_back ('\0');
+    for (size_t i = 0; i < entryCount; i++)
+        s.append (entries[i].text).append (1, '\0').append (entries[i].capitalized).push_back ('\0');
+    s.append (punctuation[0]).append (punctuation[1]).append (line_separator);
+    return s;
+}
+
+/**
+ * An upper bound on the bytes paragraphs (settings, ...) can produce, whatever the random streams,
+ * so callers can refuse a request before it exhausts memory.
+ * @param settings  a request that passes validate.
+ */
+unsigned long long LoremGenerator::maxBytes (const LoremSettings& settings) const {
+    return (unsigned long long) settings.paragraphCount * (maxParagraphBytes (settings) + 2 * line_separator.size ());
+}
+
+/**
+ * Check settings against the limits of the generator.
+ * @param settings  the request.
+ * @param error     receives a description of the first problem, if any.
+ * @return false if the settings must not be used.
+ */
+bool LoremGenerator::validate (const LoremSettings& settings, string* error) {
+    auto fail = [error] (const string& what) {
+        if (error != nullptr)
+            *error = what;
+        return false;
+    };
+    if (settings.minWordCount < 1 || settings.maxWordCount > MaxWordsPerFragment)
+        return fail ("words per fragment must be between 1 and " + to_string (MaxWordsPerFragment));
+    if (settings.maxWordCount < settings.minWordCount)
+        return fail ("maximum words per fragment is below the minimum");
+    if (settings.minSentenceCount < 1 || settings.maxSentenceCount > MaxSentencesPerParagraph)
+        return fail ("sentences per paragraph must be between 1 and " + to_string (MaxSentencesPerParagraph));
+    if (settings.maxSentenceCount < settings.minSentenceCount)
+        return fail ("maximum sentences per paragraph is below the minimum");
+    if (settings.paragraphCount < 0)
+        return fail ("the paragraph count is negative");
+    return true;
+}
+
+/**
+ * Parse a whole number as typed into a field or given on the command line: optional
+ * blanks, an optional sign and decimal digits, then optional blanks.
+ * @param text   the text.
+ * @param value  receives the number, only if the text is one that fits an int.
+ * @return false if the text is not such a number.
+ */
+bool LoremGenerator::parseInt (const string& text, int& value) {
+    auto blank = [] (char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+    size_t i = 0;
+    size_t end = text.size ();
+    while (i < end && blank (text[i]))
+        i++;
+    while (end > i && blank (text[end - 1]))
+        end--;
+
+    const bool negative = i < end && text[i] == '-';
+    if (i < end && (text[i] == '-' || text[i] == '+'))
+        i++;
+    if (i == end)
+        return false;
+    long long v = 0;
+    for (; i < end; i++) {
+        if (text[i] < '0' || text[i] > '9')
+            return false;
+        v = v * 10 + (text[i] - '0');
+        if (v > (long long) INT_MAX + 1)
+            return false;
+    }
+    v = negative ? -v : v;
+    if (v > INT_MAX)
+        return false;
+    value = (int) v;
+    return true;
+}
+
+/**
+ * Describe a set of counters, one item per line, for logs and the command line.
+ * @param stats     the counters.
+ * @param settings  the configured ranges, shown next to the observed ones.
+ * @param random    whose per-stream draw counts are shown.
+ */
+string LoremGenerator::statsReport (const LoremStats& stats, const LoremSettings& settings, const Random& random) {
+    auto range = [] (int lo, int hi) {
+        return lo > hi ? string ("none") : to_string (lo) + ".." + to_string (hi);
+    };
+    const double seconds = stats.generateSeconds;
+    char rate[64];
+    snprintf (rate, sizeof (rate), "%.3f s (%.1f MB/s)", seconds,
+              seconds > 0.0 ? stats.bytes / seconds / 1.0e6 : 0.0);
+
+    string r;
+    r.append ("words:        ").append (to_string (stats.words)).append ("\n");
+    r.append ("sentences:    ").append (to_string (stats.sentences)).append ("\n");
+    r.append ("paragraphs:   ").append (to_string (stats.paragraphs)).append ("\n");
+    r.append ("bytes:        ").append (to_string (stats.bytes)).append ("\n");
+    r.append ("allocations:  ").append (to_string (stats.allocations)).append ("\n");
+    r.append ("fragment words observed ").append (range (stats.minFragmentWords, stats.maxFragmentWords))
+     .append (", configured ").append (range (settings.minWordCount, settings.maxWordCount)).append ("\n");
+    r.append ("paragraph sentences observed ").append (range (stats.minParagraphSentences, stats.maxParagraphSentences))
+     .append (", configured ").append (range (settings.minSentenceCount, settings.maxSentenceCount)).append ("\n");
+    r.append ("generate:     ").append (rate).append ("\n");
+    snprintf (rate, sizeof (rate), "%.3f s", stats.outputSeconds);
+    r.append ("output:       ").append (rate).append ("\n");
+    for (int i = 0; i < MAX_RANDOM_STREAMS; i++)
+        if (random.draws (i) > 0)
+            r.append ("stream ").append (to_string (i)).append (" draws: ").append (to_string (random.draws (i))).append ("\n");
+    return r;
+}
+
+// Private
+
+/**
+* An upper bound on the bytes of one sentence, including the two blanks that follow it.
+*/
+unsigned long long LoremGenerator::maxSentenceBytes (const LoremSettings& settings) const {
+    const unsigned long long word = longestEntry + 1;
+    const unsigned long long fragment = (unsigned long long) max (settings.minWordCount, settings.maxWordCount) * word;
+    return word + MaxCommaFragments * (fragment + 2) + fragment + 1 + 2;
+}
+
+/**
+* An upper bound on the bytes of one paragraph, without its separator.
+*/
+unsigned long long LoremGenerator::maxParagraphBytes (const LoremSettings& settings) const {
+    const unsigned long long generated = (unsigned long long) max (settings.minSentenceCount, settings.maxSentenceCount)
+                                       * maxSentenceBytes (settings);
+    return max ((unsigned long long) standard.size (), generated);
+}
+
+/**
+* Get a random dictionary entry.
+*/
+const LoremWord& LoremGenerator::randomEntry (Session& session) const {
+    session.stats.words++;
+    return entries[session.random.uniform (1, 0, (long) entryCount - 1)];
+}
+
+/**
+* Append words, each followed by a space.
+* @param count is the number of words to fetch.
+*/
+void LoremGenerator::appendWords (string& s, int count, Session& session) const {
+    while (count-- > 0) {
+        const LoremWord& w = randomEntry (session);
+        s.append (w.text).push_back (' ');
+        session.characters += w.characters + 1;
+    }
+}
+
+/**
+ * Append a sentence fragment.
+ * @param mincount  the smallest number of possible words.
+ * @param maxcount  the largest number of possible words.
+ */
+void LoremGenerator::appendFragment (string& s, int mincount, int maxcount, Session& session) const {
+    int randInt = mincount + session.random.uniform (1, 0, maxcount-mincount);
+    observe (session.stats.minFragmentWords, session.stats.maxFragmentWords, randInt);
+    appendWords (s, randInt, session);
+}
+
+/**
+ * Append a sentence, its first word capitalized.
+ */
+void LoremGenerator::appendSentence (string& s, Session& session) const {
+    const LoremSettings& settings = session.settings;
+    session.stats.sentences++;
+
+    // first word
+    const LoremWord& w = randomEntry (session);
+    s.append (w.capitalized).push_back (' ');
+    session.characters += w.characters + 1;
+
+    // commas?
+    if (session.random.random_boolean(1)) {
+        int r = 1 + session.random.uniform (1, 0, MaxCommaFragments - 1);
+        for (int i = 0; i < r; i++) {
+            appendFragment (s, settings.minWordCount, settings.maxWordCount, session);
+            s.append (", ");
+            session.characters += 2;
+        }
+    }
+    // last fragment + punctuation
+    appendFragment (s, settings.minWordCount, settings.maxWordCount, session);
+    const string_view p = punctuation[session.random.uniform (1, 0, 1)];
+    s.append (p);
+    session.characters += p.size ();
+}
+
+/**
+ * Append a paragraph.
+ * @useStandard - append the standard Lorem Ipsum paragraph?
+ * @param minsent the minimum number of sentences
+ * @param maxsent the maximum number of sentences
+ */
+void LoremGenerator::appendParagraph (string& s, bool useStandard, int minsent, int maxsent, Session& session) const {
+    int rval = minsent + session.random.uniform (1, 0, maxsent-minsent);
+    session.stats.paragraphs++;
+    if (useStandard) {
+        s.append (standard);
+        session.characters += standard.size ();
+        return;
+    }
+    observe (session.stats.minParagraphSentences, session.stats.maxParagraphSentences, rval);
+    while (rval-- > 0) {
+        appendSentence (s, session);
+        s.append ("  ");
+        session.characters += 2;
+    }
+}
+
+/**
+* Upper case form of a code point, for the alphabets with simple one-to-one case pairs
+* (Latin-1, Latin Extended-A, Latin Extended Additional, Greek, Cyrillic, Armenian).
+* Other characters are left unchanged rather than asking the C library, whose answer
+* depends on the locale, so that a seed always gives the same text.
+*/
+static unsigned long upperCodePoint (unsigned long c) {
+    if (c >= 'a' && c <= 'z')
+        return c - 0x20;
+    if (c < 0x80)
+        return c;
+    if (c >= 0xE0 && c <= 0xFE && c != 0xF7)
+        return c - 0x20;
+    if (c == 0xFF)
+        return 0x178;
+    if (c >= 0x100 && c <= 0x17F) {
+        if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E))
+            return (c & 1) ? c : c - 1;
+        if (c == 0x131 || c == 0x138 || c == 0x149 || c == 0x17F)
+            return c;
+        return (c & 1) ? c - 1 : c;
+    }
+    if (c >= 0x3B1 && c <= 0x3CB && c != 0x3C2)
+        return c - 0x20;
+    if (c == 0x3C2)
+        return 0x3A3;
+    if (c == 0x3AC)
+        return 0x386;
+    if (c >= 0x3AD && c <= 0x3AF)
+        return c - 0x25;
+    if (c == 0x3CC)
+        return 0x38C;
+    if (c == 0x3CD || c == 0x3CE)
+        return c - 0x3F;
+    if (c >= 0x430 && c <= 0x44F)
+        return c - 0x20;
+    if (c >= 0x450 && c <= 0x45F)
+        return c - 0x50;
+    if (c >= 0x561 && c <= 0x586)
+        return c - 0x30;
+    if ((c >= 0x1E00 && c <= 0x1E95) || (c >= 0x1EA0 && c <= 0x1EFF))
+        return (c & 1) ? c - 1 : c;
+    return c;
+}
+
+/**
+* Upper case the first character of a UTF-8 word.
+* @param word  the word; malformed UTF-8 is returned unchanged.
+*/
+string LoremGenerator::capitalize (const string& word) {
+    if (word.empty ())
+        return word;
+
+    const unsigned char lead = (unsigned char) word[0];
+    const size_t len = utf8SequenceLength (lead);
+    if (len > word.size ())
+        return word;
+
+    unsigned long c = len == 1 ? lead : lead & (0xFF >> (len + 1));
+    for (size_t i = 1; i < len; i++) {
+        if (((unsigned char) word[i] & 0xC0) != 0x80)
+            return word;
+        c = (c << 6) | ((unsigned char) word[i] & 0x3F);
+    }
+
+    const unsigned long u = upperCodePoint (c);
+    string s;
+    if (u < 0x80) {
+        s.push_back ((char) u);
+    } else if (u < 0x800) {
+        s.push_back ((char) (0xC0 | (u >> 6)));
+        s.push_back ((char) (0x80 | (u & 0x3F)));
+    } else if (u < 0x10000) {
+        s.push_back ((char) (0xE0 | (u >> 12)));
+        s.push_back ((char) (0x80 | ((u >> 6) & 0x3F)));
+        s.push_back ((char) (0x80 | (u & 0x3F)));
+    } else {
+        s.push_back ((char) (0xF0 | (u >> 18)));
+        s.push_back ((char) (0x80 | ((u >> 12) & 0x3F)));
+        s.push_back ((char) (0x80 | ((u >> 6) & 0x3F)));
+        s.push_back ((char) (0x80 | (u & 0x3F)));
+    }
+    return s.append (word, len, string::npos);
+}
+
+/**
+* Count the characters (code points) in UTF-8 text.
+*/
+size_t LoremGenerator::characterCount (const string& text) {
+    size_t n = 0;
+    for (unsigned char c : text)
+        if ((c & 0xC0) != 0x80)
+            n++;
+    return n;
+}
@@ -0,0 +1,188 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     LoremGenerator.h                                    */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     The Lorem Ipsum text engine, free of any GUI dependencies so that it  */
+/*     can be driven from the main window or from the command line.          */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     Based on Java code by Oliver C. Dodd                                  */
+/*     The const methods only read the generator (dictionary and canned      */
+/*     text); the settings, random streams and counters of a request are     */
+/*     passed in, so one generator can serve any number of threads as long   */
+/*     as each brings its own Random and LoremStats.  The non-const methods  */
+/*     are the single threaded convenience form using the members below.     */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:        JL Sowers    09JUN24                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _LOREMGENERATOR_H_
+#define   _LOREMGENERATOR_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Random.h"
+
+/**
+* The user adjustable generation parameters.
+* Passed by const reference and never modified while generating.
+* LoremGenerator::validate checks them against the generator's limits.
+*/
+struct LoremSettings {
+	int minWordCount = 3;
+	int maxWordCount = 17;
+	int minSentenceCount = 1;
+	int maxSentenceCount = 5;
+	int paragraphCount = 1;
+	bool useStandard = false;
+};
+
+/**
+* Counters kept while generating, cheap enough to leave on.
+* Observed ranges are empty (lo > hi) until something has been generated.
+*/
+struct LoremStats {
+	unsigned long long words = 0;
+	unsigned long long sentences = 0;
+	unsigned long long paragraphs = 0;
+	unsigned long long bytes = 0;
+	unsigned long long allocations = 0;
+	int minFragmentWords = 0;
+	int maxFragmentWords = -1;
+	int minParagraphSentences = 0;
+	int maxParagraphSentences = -1;
+	double generateSeconds = 0.0;
+	double outputSeconds = 0.0;
+};
+
+/**
+* A dictionary word with its case forms and length worked out once, at load time,
+* so that UTF-8 text costs no more to generate than ASCII.
+* The views point into static data or into the generator's own storage.
+*/
+struct LoremWord {
+	std::string_view text;
+	std::string_view capitalized;
+	size_t characters;
+};
+
+
+class LoremGenerator {
+
+public:
+	/**
+	* Part of every fingerprint; bump it whenever the same seed, settings and dictionary
+	* produce different text, so that documents cached by older builds are never served.
+	*/
+	static constexpr int EngineVersion = 1;
+	static constexpr int MaxWordsPerFragment = 100;
+	static constexpr int MaxSentencesPerParagraph = 100;
+
+	LoremGenerator ();
+	~LoremGenerator ();
+
+	std::string randomWord ();
+	std::string randomPunctuation ();
+	std::string wordString (int count);
+	std::string sentenceFragment (int mincount, int maxcount);
+	std::string sentenceFragment ();
+	std::string sentence ();
+	std::string sentences (int count);
+	std::string paragraph (bool useStandard, int minsent, int maxsent);
+	std::string paragraph (bool useStandard);
+	std::string paragraph ();
+	std::string paragraphs (int count, bool useStandard);
+	std::string paragraphs (int count);
+	void appendParagraphs (std::string& s, int count, bool useStandard);
+	bool paragraphs (int count, bool useStandard, size_t chunkSize, const std::function<bool (std::string&&)>& sink);
+	std::string characters (size_t count);
+
+	void appendParagraphs (std::string& s, const LoremSettings& settings, Random& random, LoremStats& stats) const;
+	std::string paragraphs (const LoremSettings& settings, Random& random, LoremStats& stats) const;
+	bool paragraphs (const LoremSettings& settings, Random& random, LoremStats& stats,
+	                 size_t chunkSize, const std::function<bool (std::string&&)>& sink) const;
+	std::string characters (size_t count, const LoremSettings& settings, Random& random, LoremStats& stats) const;
+	std::string fingerprint (const LoremSettings& settings, const Random& random) const;
+	unsigned long long maxBytes (const LoremSettings& settings) const;
+
+	static bool validate (const LoremSettings& settings, std::string* error = nullptr);
+	static bool parseInt (const std::string& text, int& value);
+
+	static std::string_view standardParagraph () { return standard; }
+
+	bool setDictionary (const std::vector<std::string>& words);
+	bool setDictionary (const std::string& text);
+	size_t dictionarySize () const { return entryCount; }
+
+	const LoremStats& stats () const { return counters; }
+	void resetStats ();
+	std::string statsReport () const;
+	static std::string statsReport (const LoremStats& stats, const LoremSettings& settings, const Random& random);
+
+	static std::string capitalize (const std::string& word);
+	static size_t characterCount (const std::string& text);
+
+	std::string fingerprint (int count, bool useStandard) const;
+
+	LoremSettings settings;
+	Random random;
+
+private:
+	friend class LoremTemplate;
+
+	LoremGenerator (const LoremGenerator&) = delete;
+	LoremGenerator& operator= (const LoremGenerator&) = delete;
+
+	static constexpr int MaxCommaFragments = 4;
+
+	/**
+	* Everything a single request may modify while it runs.
+	*/
+	struct Session {
+		const LoremSettings& settings;
+		Random& random;
+		LoremStats& stats;
+		size_t characters;
+	};
+
+    static constexpr std::string_view standard = "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.  Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.";
+
+	static constexpr std::string_view punctuation[2] = { ".", "?" };
+	static constexpr std::string_view line_separator = "\n";
+
+	const LoremWord* entries;
+	size_t entryCount;
+	size_t longestEntry;
+	std::vector<LoremWord> customEntries;
+	std::string customText;
+
+	LoremStats counters;
+
+	const LoremWord& randomEntry (Session& session) const;
+	void appendWords (std::string& s, int count, Session& session) const;
+	void appendFragment (std::string& s, int mincount, int maxcount, Session& session) const;
+	void appendSentence (std::string& s, Session& session) const;
+	void appendParagraph (std::string& s, bool useStandard, int minsent, int maxsent, Session& session) const;
+	unsigned long long maxSentenceBytes (const LoremSettings& settings) const;
+	unsigned long long maxParagraphBytes (const LoremSettings& settings) const;
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    LoremGenerator.h                                       */
+/*****************************************************************************/
\ No newline at end of file
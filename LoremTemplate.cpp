@@ -0,0 +1,271 @@
+/****************************************************************************/
+/* BEGIN FILE             LoremTemplate.cpp                                 */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Compiles and renders document layout templates.                   */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        Rendering appends straight into the caller's buffer using the     */
+/*        generator's own append primitives.                                */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <chrono>
+#include <cstdlib>
+#include "LoremTemplate.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+static const int MaxPlaceholderCount = 100000;
+
+/**
+* Placeholder names with their default count ranges.
+*/
+const LoremTemplate::Placeholder LoremTemplate::Placeholders[] = {
+    { "title",    Title,      2, 6 },
+    { "byline",   Byline,     2, 2 },
+    { "words",    Words,      5, 10 },
+    { "sentence", Sentences,  1, 1 },
+    { "para",     Paragraphs, 1, 1 },
+    { "list",     List,       3, 6 },
+};
+
+/**
+* Drop trailing blanks appended since a given offset.
+*/
+static inline void trimRight (string& s, size_t floor) {
+    while (s.size () > floor && s.back () == ' ')
+        s.pop_back ();
+}
+
+/****************************************************************************/
+
+/**
+* Default Constructor.  An empty template renders nothing.
+*/
+LoremTemplate::LoremTemplate () {
+}
+
+/**
+* Default Destructor.
+*/
+LoremTemplate::~LoremTemplate () {
+    // Null
+}
+
+/**
+* Compile a template, replacing any previous program.
+* @param source  the template text.
+* @param error   receives a description of the first problem, if any.
+* @return false (leaving the previous program in place) if the template is malformed.
+*/
+bool LoremTemplate::compile (const string& source, string* error) {
+    vector<Instruction> compiled;
+    auto fail = [error] (size_t pos, const string& what) {
+        if (error != nullptr)
+            *error = "position " + to_string (pos) + ": " + what;
+        return false;
+    };
+    auto literal = [&compiled] (char c) {
+        if (compiled.empty () || compiled.back ().op != Literal)
+            compiled.push_back (Instruction { Literal, 0, 0, string () });
+        compiled.back ().text.push_back (c);
+    };
+
+    for (size_t i = 0; i < source.size (); i++) {
+        const char c = source[i];
+        if (c == '\\') {
+            if (++i == source.size ())
+                return fail (i - 1, "dangling \\");
+            const char e = source[i];
+            if (e != 'n' && e != 't' && e != '\\' && e != '{' && e != '}')
+                return fail (i - 1, string ("unknown escape \\") + e);
+            literal (e == 'n' ? '\n' : e == 't' ? '\t' : e);
+        } else if (c == '}') {
+            return fail (i, "unmatched }");
+        } else if (c != '{') {
+            literal (c);
+        } else {
+            const size_t close = source.find ('}', i);
+            if (close == string::npos)
+                return fail (i, "unterminated {");
+            const string body = source.substr (i + 1, close - i - 1);
+            const size_t colon = body.find (':');
+            const string name = body.substr (0, colon);
+
+            size_t p = 0;
+            const size_t count = sizeof (Placeholders) / sizeof (Placeholders[0]);
+            while (p < count && name != Placeholders[p].name)
+                p++;
+            if (p == count)
+                return fail (i, "unknown placeholder {" + body + "}");
+
+            Instruction in { Placeholders[p].op, Placeholders[p].minCount, Placeholders[p].maxCount, string () };
+            if (colon != string::npos) {
+                const string range = body.substr (colon + 1);
+                const char* s = range.c_str ();
+                char* end = nullptr;
+                const long lo = strtol (s, &end, 10);
+                long hi = lo;
+                if (end == s || lo < 0)
+                    return fail (i, "bad count in {" + body + "}");
+                if (*end == '-') {
+                    const char* h = end + 1;
+                    hi = strtol (h, &end, 10);
+                    if (end == h)
+                        return fail (i, "bad count in {" + body + "}");
+                }
+                if (*end != '\0' || hi < lo || hi > MaxPlaceholderCount)
+                    return fail (i, "bad count in {" + body + "}");
+                in.minCount = (int) lo;
+                in.maxCount = (int) hi;
+            }
+            compiled.push_back (in);
+            i = close;
+        }
+    }
+
+    program.swap (compiled);
+    return true;
+}
+
+/**
+* An upper bound on the bytes one render can append, whatever the random streams.
+* @param generator  supplies the words.
+* @param settings   word and sentence ranges, which must pass LoremGenerator::validate.
+*/
+unsigned long long LoremTemplate::maxBytes (const LoremGenerator& generator, const LoremSettings& settings) const {
+    const unsigned long long word = generator.longestEntry + 1;
+    const unsigned long long fragment = (unsigned long long) settings.maxWordCount * word;
+    const unsigned long long separator = generator.line_separator.size ();
+    unsigned long long total = 0;
+
+    for (const Instruction& in : program) {
+        const unsigned long long n = (unsigned long long) in.maxCount;
+        switch (in.op) {
+        case Literal:
+            total += in.text.size ();
+            break;
+        case Title:
+        case Byline:
+            total += 3 + n * word;
+            break;
+        case Words:
+            total += n * word;
+            break;
+        case Sentences:
+            total += n * generator.maxSentenceBytes (settings);
+            break;
+        case Paragraphs:
+            total += n * (generator.maxParagraphBytes (settings) + 2 * separator);
+            break;
+        case List:
+            total += n * (2 + word + fragment + separator);
+            break;
+        }
+    }
+    return total;
+}
+
+/**
+* Render the template once, appending to a buffer.  Safe to call concurrently
+* as long as every caller has its own random and stats.
+* @param generator  supplies the words.
+* @param settings   word and sentence ranges for the placeholders that use them.
+* @param random     supplies the randomness.
+* @param stats      the counters to update.
+* @param out        the text is appended here.
+*/
+void LoremTemplate::render (const LoremGenerator& generator, const LoremSettings& settings,
+                            Random& random, LoremStats& stats, string& out) const {
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now ();
+    const size_t begin = out.size ();
+    LoremGenerator::Session session { settings, random, stats, 0 };
+
+    for (const Instruction& in : program) {
+        int n = in.minCount;
+        if (in.maxCount > in.minCount)
+            n += random.uniform (1, 0, in.maxCount - in.minCount);
+
+        const size_t mark = out.size ();
+        switch (in.op) {
+        case Literal:
+            out.append (in.text);
+            break;
+        case Title:
+        case Byline:
+            if (in.op == Byline)
+                out.append ("By ");
+            for (int i = 0; i < n; i++) {
+                if (i > 0)
+                    out.push_back (' ');
+                out.append (generator.randomEntry (session).capitalized);
+            }
+            break;
+        case Words:
+            generator.appendWords (out, n, session);
+            trimRight (out, mark);
+            break;
+        case Sentences:
+            for (int i = 0; i < n; i++) {
+                generator.appendSentence (out, session);
+                out.append ("  ");
+            }
+            trimRight (out, mark);
+            break;
+        case Paragraphs:
+            for (int i = 0; i < n; i++) {
+                if (i > 0)
+                    out.append (generator.line_separator).append (generator.line_separator);
+                generator.appendParagraph (out, false, settings.minSentenceCount, settings.maxSentenceCount, session);
+                trimRight (out, mark);
+            }
+            break;
+        case List:
+            for (int i = 0; i < n; i++) {
+                const size_t item = out.size ();
+                out.append ("- ").append (generator.randomEntry (session).capitalized).push_back (' ');
+                generator.appendFragment (out, settings.minWordCount, settings.maxWordCount, session);
+                trimRight (out, item);
+                out.append (generator.line_separator);
+            }
+            break;
+        }
+    }
+
+    stats.bytes += out.size () - begin;
+    stats.generateSeconds += chrono::duration<double> (chrono::steady_clock::now () - start).count ();
+}
+
+/**
+* Render the template once, appending to a buffer.
+* @param generator  supplies the words, settings and randomness.
+* @param out        the text is appended here.
+*/
+void LoremTemplate::render (LoremGenerator& generator, string& out) const {
+    render (generator, generator.settings, generator.random, generator.counters, out);
+}
+
+/**
+* Render the template once.
+* @param generator  supplies the words and randomness.
+*/
+string LoremTemplate::render (LoremGenerator& generator) const {
+    string s;
+    render (generator, s);
+    return s;
+}
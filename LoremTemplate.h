@@ -0,0 +1,83 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     LoremTemplate.h                                     */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     Document layouts such as "{title}\n{para:2-4}\n{list:3-6}" compiled   */
+/*     once and then rendered any number of times.                           */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     Placeholders are {name}, {name:N} or {name:N-M} where name is one of  */
+/*     title, byline, words, sentence, para or list and N-M the count range  */
+/*     (words, sentences, paragraphs or list items).  \n, \t, \\, \{ and \}  */
+/*     are escapes; everything else is copied literally.  Compiling turns    */
+/*     the source into a flat instruction array so rendering never parses.  */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _LOREMTEMPLATE_H_
+#define   _LOREMTEMPLATE_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "LoremGenerator.h"
+
+
+class LoremTemplate {
+
+public:
+	LoremTemplate ();
+	~LoremTemplate ();
+
+	bool compile (const std::string& source, std::string* error = nullptr);
+	void render (const LoremGenerator& generator, const LoremSettings& settings,
+	             Random& random, LoremStats& stats, std::string& out) const;
+	void render (LoremGenerator& generator, std::string& out) const;
+	std::string render (LoremGenerator& generator) const;
+
+	bool isEmpty () const { return program.empty (); }
+	unsigned long long maxBytes (const LoremGenerator& generator, const LoremSettings& settings) const;
+
+private:
+	enum Op { Literal, Title, Byline, Words, Sentences, Paragraphs, List };
+
+	struct Instruction {
+		Op op;
+		int minCount;
+		int maxCount;
+		std::string text;
+	};
+
+	/**
+	* A placeholder name with its instruction and default count range.
+	*/
+	struct Placeholder {
+		const char* name;
+		Op op;
+		int minCount;
+		int maxCount;
+	};
+
+	static const Placeholder Placeholders[];
+
+	std::vector<Instruction> program;
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    LoremTemplate.h                                        */
+/*****************************************************************************/
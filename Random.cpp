@@ -11,6 +11,8 @@
 *
 *   Initial Code:     Joseph Sowers, PhD     01 JUL 94
 *   Modifications:    JL Sowers              11 JUN 24  Added boolean return methods.
+*                                            19 OCT 26  Per-thread instances from a master seed.
+*                                            19 OCT 26  Ziggurat, Poisson, Zipf and alias samplers.
 *--------------------------------------------------------------------------
 * INCLUDE FILES
 */
@@ -19,26 +21,166 @@
 #include <stdio.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cmath>
 #include "Random.h"
 
 /**
 *--------------------------------------------------------------------------
 * DEFINES
-*       None
+*--------------------------------------------------------------------------
+*/
+
+// A draw is 31 bits: the low 7 (normal) or 8 (exponential) pick the
+// Ziggurat layer and the remaining 24 or 23 bits are the position in it.
+#define ZIGGURAT_NORMAL_LAYERS       128
+#define ZIGGURAT_EXPONENTIAL_LAYERS  256
+#define ZIGGURAT_NORMAL_SCALE        8388608.0      // 2^23
+#define ZIGGURAT_EXPONENTIAL_SCALE   8388608.0      // 2^23
+#define ZIGGURAT_NORMAL_R            3.442619855899
+#define ZIGGURAT_EXPONENTIAL_R       7.697117470131487
+#define POISSON_INVERSION_LIMIT      12.0
+
+/**
+* Layer tables of both Ziggurats, read only once built.
+*/
+typedef struct {
+	long   kn[ZIGGURAT_NORMAL_LAYERS];
+	double wn[ZIGGURAT_NORMAL_LAYERS];
+	double fn[ZIGGURAT_NORMAL_LAYERS];
+	long   ke[ZIGGURAT_EXPONENTIAL_LAYERS];
+	double we[ZIGGURAT_EXPONENTIAL_LAYERS];
+	double fe[ZIGGURAT_EXPONENTIAL_LAYERS];
+} ziggurat_type;
+
+/**
+* Build the Ziggurat tables (Marsaglia and Tsang, 2000).
+*/
+static ziggurat_type build_ziggurat() {
+	ziggurat_type z;
+	const double vn = 9.91256303526217e-3;
+	const double ve = 3.949659822581572e-3;
+	double dn = ZIGGURAT_NORMAL_R, tn = dn;
+	double de = ZIGGURAT_EXPONENTIAL_R, te = de;
+	double q;
+	int i;
+
+	q = vn / exp(-0.5 * dn * dn);
+	z.kn[0] = (long) ((dn / q) * ZIGGURAT_NORMAL_SCALE);
+	z.kn[1] = 0;
+	z.wn[0] = q / ZIGGURAT_NORMAL_SCALE;
+	z.wn[ZIGGURAT_NORMAL_LAYERS - 1] = dn / ZIGGURAT_NORMAL_SCALE;
+	z.fn[0] = 1.0;
+	z.fn[ZIGGURAT_NORMAL_LAYERS - 1] = exp(-0.5 * dn * dn);
+	for (i = ZIGGURAT_NORMAL_LAYERS - 2; i >= 1; i--) {
+		dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+		z.kn[i + 1] = (long) ((dn / tn) * ZIGGURAT_NORMAL_SCALE);
+		tn = dn;
+		z.fn[i] = exp(-0.5 * dn * dn);
+		z.wn[i] = dn / ZIGGURAT_NORMAL_SCALE;
+	}
+
+	q = ve / exp(-de);
+	z.ke[0] = (long) ((de / q) * ZIGGURAT_EXPONENTIAL_SCALE);
+	z.ke[1] = 0;
+	z.we[0] = q / ZIGGURAT_EXPONENTIAL_SCALE;
+	z.we[ZIGGURAT_EXPONENTIAL_LAYERS - 1] = de / ZIGGURAT_EXPONENTIAL_SCALE;
+	z.fe[0] = 1.0;
+	z.fe[ZIGGURAT_EXPONENTIAL_LAYERS - 1] = exp(-de);
+	for (i = ZIGGURAT_EXPONENTIAL_LAYERS - 2; i >= 1; i--) {
+		de = -log(ve / de + exp(-de));
+		z.ke[i + 1] = (long) ((de / te) * ZIGGURAT_EXPONENTIAL_SCALE);
+		te = de;
+		z.fe[i] = exp(-de);
+		z.we[i] = de / ZIGGURAT_EXPONENTIAL_SCALE;
+	}
+	return z;
+}
+
+/**
+* The Ziggurat tables, built on first use so that programs which never
+* draw a normal or exponential deviate pay nothing at startup.
+*/
+static const ziggurat_type& ziggurat_tables() {
+	static const ziggurat_type z = build_ziggurat();
+	return z;
+}
+
+/**
+* The constants of a Zipf distribution used by rejection-inversion
+* (Hormann and Derflinger, 1996), worked out once per call or batch.
+*/
+typedef struct {
+	long n;
+	double exponent;
+	double h_integral_x1;
+	double h_integral_n;
+	double s;
+} zipf_type;
+
+static double zipf_helper1(double x) {
+	return fabs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+static double zipf_helper2(double x) {
+	return fabs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+}
+
+static double zipf_h(const zipf_type &z, double x) {
+	return exp(-z.exponent * log(x));
+}
+
+static double zipf_h_integral(const zipf_type &z, double x) {
+	double log_x = log(x);
+	return zipf_helper2((1.0 - z.exponent) * log_x) * log_x;
+}
+
+static double zipf_h_integral_inverse(const zipf_type &z, double x) {
+	double t = x * (1.0 - z.exponent);
+	if (t < -1.0)
+		t = -1.0;
+	return exp(zipf_helper1(t) * x);
+}
+
+static zipf_type zipf_setup(long n, double exponent) {
+	zipf_type z;
+	z.n = n;
+	z.exponent = exponent;
+	z.h_integral_x1 = zipf_h_integral(z, 1.5) - 1.0;
+	z.h_integral_n = zipf_h_integral(z, n + 0.5);
+	z.s = 2.0 - zipf_h_integral_inverse(z, zipf_h_integral(z, 2.5) - zipf_h(z, 2.0));
+	return z;
+}
+
+/**
 *--------------------------------------------------------------------------
 * BEGIN CODE
 */
 
-//  Default Constructor
+//  Default Constructor, every stream at its fixed initial state
 Random::Random() {
 	init();
+	reset(-1);
+}
+
+/**
+* Construct the generator of one thread, its streams derived from a master seed.
+* @param master  the master seed shared by all threads.
+* @param thread  index of the thread; each index gives unrelated streams.
+*/
+Random::Random(unsigned long long master, unsigned long long thread) {
+	init();
+	set_seed(master, thread);
 }
 
 /**
 * Default Destructor.
 */
 Random::~Random() {
-	// Null
+	int i;
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++) {
+		free_random_list(i);
+		free_alias_table(i);
+	}
 }
 
 /**
@@ -62,9 +204,23 @@ void Random::init() {
 	initial_seed_array[6].seed_2 = 1522062797;
 	initial_seed_array[7].seed_1 = 747819450;
 	initial_seed_array[7].seed_2 = 1460277304;
-	ranlist_top = 0;
-	for (i = 0; i < MAX_RANDOM_STREAMS; i++)
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++) {
+		ranlist_top[i] = 0;
 		ranlist_head[i] = NULL;
+		alias_size[i] = 0;
+		alias_prob[i] = NULL;
+		alias_index[i] = NULL;
+	}
+	reset_draws();
+}
+
+/**
+* Zero the per-stream counts of values drawn.
+*/
+void Random::reset_draws() {
+	int i;
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++)
+		draw_count[i] = 0;
 }
 
 /**
@@ -86,6 +242,66 @@ void Random::reset(int stream = -1) {
 	}
 }
 
+/**
+* Derive the initial state of every stream from a single master seed and reset to it.
+* Uses a SplitMix64 sequence so nearby master seeds still give unrelated streams.
+* @param master  the master seed.
+*/
+void Random::set_seed(unsigned long long master) {
+	set_seed(master, 0);
+}
+
+/**
+* Derive the initial state of every stream from a master seed and a thread index, and reset to it.
+* Thread 0 gets the same streams as set_seed(master).
+* @param master  the master seed.
+* @param thread  index of the thread using this instance.
+*/
+void Random::set_seed(unsigned long long master, unsigned long long thread) {
+	const long m1 = 2147483563;
+	const long m2 = 2147483399;
+	unsigned long long x = master;
+	int i;
+
+	if (thread != 0) {
+		unsigned long long t = thread * 0xD1B54A32D192ED03ULL;
+		t = (t ^ (t >> 32)) * 0xDABA0B6EB09322E3ULL;
+		x ^= t ^ (t >> 32);
+	}
+
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++) {
+		unsigned long long z;
+
+		z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z ^= z >> 31;
+		initial_seed_array[i].seed_1 = 1 + (long) ((z & 0xFFFFFFFFULL) % (m1 - 1));
+		initial_seed_array[i].seed_2 = 1 + (long) ((z >> 32) % (m2 - 1));
+	}
+	reset(-1);
+}
+
+/**
+* Copy the current state of every stream.
+* @param state  receives the state; restore it later with set_state.
+*/
+void Random::get_state(seed_array state) const {
+	int i;
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++)
+		state[i] = seed[i];
+}
+
+/**
+* Restore every stream to a state previously obtained from get_state.
+* @param state  the saved state.
+*/
+void Random::set_state(const seed_array state) {
+	int i;
+	for (i = 0; i < MAX_RANDOM_STREAMS; i++)
+		seed[i] = state[i];
+}
+
 /**
 * Generate a random double value from a uniform distribution.
 * @param stream the stream to select from.
@@ -103,28 +319,244 @@ double Random::duniform(int stream = 0, double lower = 0.0, double upper = 1.0)
 * @param stream the stream to select from.
 * @param lower  lowest value possible (default = 0L)
 * @param upper  highest value possible (default = 100L)
-* @return a double value in the interval [0L, 100L)
+* @return a long value in the interval [lower, upper], each equally likely; lower if upper < lower.
 */
 long Random::uniform(int stream = 0, long lower = 0L, long upper = 100L) {
 	double r = unif(stream);
-	return ((long) (lower + r * (upper - lower)));
+	long value;
+
+	if (upper < lower)
+		upper = lower;
+	value = lower + (long) (r * ((double) (upper - lower) + 1.0));
+	return (value > upper ? upper : value);
 }
 
 
 /**
 * Generate a random double value from a Normal distribution.
+* Ziggurat method: about 99% of samples cost one draw and a multiply.
 * @param stream the stream to select from.
 * @param mean  average value  (default 0.0)
 * @param sigma  standard deviation (default 0.1)
 * @return a double value
 */
 double Random::normal(int stream = 0, double mean = 0.0, double sigma = 0.1) {
-	int j;
-	double return_value = 0.0;
+	const ziggurat_type &ziggurat = ziggurat_tables();
+	long z = next(stream);
+	int i = (int) (z & (ZIGGURAT_NORMAL_LAYERS - 1));
+	long j = (z >> 7) - (1L << 23);
+
+	if (labs(j) < ziggurat.kn[i])
+		return mean + sigma * (j * ziggurat.wn[i]);
+	return mean + sigma * normal_tail(stream, j, i);
+}
+
+/**
+* Generate a random double value from an exponential distribution.
+* Ziggurat method: about 99% of samples cost one draw and a multiply.
+* @param stream the stream to select from.
+* @param mean  average value (1 / rate).
+* @return a double value, never negative.
+*/
+double Random::exponential(int stream, double mean) {
+	const ziggurat_type &ziggurat = ziggurat_tables();
+	long z = next(stream);
+	int i = (int) (z & (ZIGGURAT_EXPONENTIAL_LAYERS - 1));
+	long j = z >> 8;
 
-	for (j = 0; j < 12; j++)
-		return_value += unif(stream);
-	return (double) (mean + sigma * (return_value - 6.0));
+	if (j < ziggurat.ke[i])
+		return mean * (j * ziggurat.we[i]);
+	return mean * exponential_tail(stream, j, i);
+}
+
+/**
+* Generate a random long value from a Poisson distribution.
+* Small means use inversion (one draw), larger ones Hormann's PTRS
+* transformed rejection (about 2.3 draws whatever the mean).
+* @param stream the stream to select from.
+* @param mean  average value, 0 or more.
+* @return a long value, 0 or more.
+*/
+long Random::poisson(int stream, double mean) {
+	double u, p, f;
+	long k;
+
+	if (mean <= 0.0)
+		return 0;
+	if (mean >= POISSON_INVERSION_LIMIT)
+		return poisson_ptrs(stream, mean);
+
+	u = unif(stream);
+	p = exp(-mean);
+	f = p;
+	for (k = 0; u > f && k < 1000; ) {
+		k++;
+		p *= mean / k;
+		f += p;
+	}
+	return k;
+}
+
+/**
+* Generate a random long value from a Zipf distribution: k has probability proportional to 1 / k^exponent.
+* Rejection-inversion, needing no table and usually a single draw.
+* @param stream   the stream to select from.
+* @param n        largest value possible, 1 or more.
+* @param exponent 0 or more; 0 is uniform, larger values favour small k.
+* @return a long value in the interval [1, n].
+*/
+long Random::zipf(int stream, long n, double exponent) {
+	long k;
+	zipf_batch(stream, n, exponent, &k, 1);
+	return k;
+}
+
+/**
+* Fill an array with normal deviates.
+* @see normal
+*/
+void Random::normal_batch(int stream, double mean, double sigma, double *out, long count) {
+	long c;
+	for (c = 0; c < count; c++)
+		out[c] = normal(stream, mean, sigma);
+}
+
+/**
+* Fill an array with exponential deviates.
+* @see exponential
+*/
+void Random::exponential_batch(int stream, double mean, double *out, long count) {
+	long c;
+	for (c = 0; c < count; c++)
+		out[c] = exponential(stream, mean);
+}
+
+/**
+* Fill an array with Poisson deviates.
+* @see poisson
+*/
+void Random::poisson_batch(int stream, double mean, long *out, long count) {
+	long c;
+	for (c = 0; c < count; c++)
+		out[c] = poisson(stream, mean);
+}
+
+/**
+* Fill an array with Zipf deviates, working the distribution constants out only once.
+* @see zipf
+*/
+void Random::zipf_batch(int stream, long n, double exponent, long *out, long count) {
+	zipf_type z;
+	long c;
+
+	if (n <= 1 || exponent < 0.0) {
+		for (c = 0; c < count; c++)
+			out[c] = 1;
+		return;
+	}
+	z = zipf_setup(n, exponent);
+	for (c = 0; c < count; c++) {
+		for (;;) {
+			double u = z.h_integral_n + unif(stream) * (z.h_integral_x1 - z.h_integral_n);
+			double x = zipf_h_integral_inverse(z, u);
+			long k = (long) (x + 0.5);
+
+			if (k < 1)
+				k = 1;
+			else if (k > n)
+				k = n;
+			if (k - x <= z.s || u >= zipf_h_integral(z, k + 0.5) - zipf_h(z, (double) k)) {
+				out[c] = k;
+				break;
+			}
+		}
+	}
+}
+
+/**
+* Builds an alias table for a discrete distribution and assigns it to a stream (Vose's method).
+* @see alias
+* @param stream   the stream used.
+* @param weights  relative weight of each value 0 to n-1; need not sum to 1, none negative.
+* @param n        number of values.
+*/
+void Random::create_alias_table(int stream, const double *weights, long n) {
+	long *small, *large;
+	long ns = 0, nl = 0;
+	double total = 0.0;
+	long i;
+
+	free_alias_table(stream);
+	if (n <= 0)
+		return;
+	for (i = 0; i < n; i++)
+		total += weights[i];
+	if (total <= 0.0)
+		return;
+
+	alias_prob[stream] = new double[n];
+	alias_index[stream] = new long[n];
+	alias_size[stream] = n;
+	small = new long[n];
+	large = new long[n];
+
+	for (i = 0; i < n; i++) {
+		alias_prob[stream][i] = weights[i] * n / total;
+		alias_index[stream][i] = i;
+		if (alias_prob[stream][i] < 1.0)
+			small[ns++] = i;
+		else
+			large[nl++] = i;
+	}
+	while (ns > 0 && nl > 0) {
+		long s = small[--ns];
+		long l = large[nl - 1];
+
+		alias_index[stream][s] = l;
+		alias_prob[stream][l] -= 1.0 - alias_prob[stream][s];
+		if (alias_prob[stream][l] < 1.0) {
+			nl--;
+			small[ns++] = l;
+		}
+	}
+	// Whatever is left is 1 up to rounding.
+	while (nl > 0)
+		alias_prob[stream][large[--nl]] = 1.0;
+	while (ns > 0)
+		alias_prob[stream][small[--ns]] = 1.0;
+
+	delete[] small;
+	delete[] large;
+}
+
+/**
+* Draws a value from the discrete distribution given to create_alias_table, with a single draw.
+* Note that method create_alias_table must be called prior to using this method.
+* @param stream stream used to define the table used.
+* @return a long value in the interval [0, n-1], or -1 if the stream has no table.
+*/
+long Random::alias(int stream) {
+	long n = alias_size[stream];
+	double u;
+	long i;
+
+	if (n <= 0)
+		return -1;
+	u = unif(stream) * n;
+	i = (long) u;
+	if (i >= n)
+		i = n - 1;
+	return (u - i) < alias_prob[stream][i] ? i : alias_index[stream][i];
+}
+
+/**
+* Fill an array with values drawn from a stream's alias table.
+* @see alias
+*/
+void Random::alias_batch(int stream, long *out, long count) {
+	long c;
+	for (c = 0; c < count; c++)
+		out[c] = alias(stream);
 }
 
 /**
@@ -134,7 +566,7 @@ double Random::normal(int stream = 0, double mean = 0.0, double sigma = 0.1) {
 */
 bool Random::random_boolean (int stream, int pcnt=50) {
 	bool return_value = false;
-	if (uniform () < pcnt) return_value = true;
+	if (uniform (stream, 0L, 99L) < pcnt) return_value = true;
 	return return_value;
 }
 
@@ -158,6 +590,8 @@ void Random::create_random_list(int stream = 0, long list_length = 999l) {
 	ranlist_type *ptr;
 	ranlist_type *prior = NULL;
 
+	free_random_list(stream);
+
 	for (i = 0; i < list_length; i++) {
 		ptr = new ranlist_type;
 		ptr->number = i;
@@ -169,7 +603,7 @@ void Random::create_random_list(int stream = 0, long list_length = 999l) {
 		prior = ptr;
 	}
 
-	ranlist_top = list_length;
+	ranlist_top[stream] = list_length;
 	ranlist_head[stream] = start;
 }
 
@@ -180,14 +614,18 @@ void Random::create_random_list(int stream = 0, long list_length = 999l) {
 * Note that 'deal' implies selecting without repeat (aka deal the cards)
 * So for a card deck, you would initialise the stream used by calling create_random_list(0, 52)
 * @param stream stream used to define the list used.
+* @return the number dealt, or -1 once the list is exhausted.
 */
 long Random::deal_random_number(int stream = 0) {
 	long i;
 	long deal;
-	long r = uniform(stream, 0L, ranlist_top);
+	long r;
 	ranlist_type *prior = NULL;
 	ranlist_type *ptr;
 
+	if (ranlist_top[stream] <= 0)
+		return -1;
+	r = uniform(stream, 0L, ranlist_top[stream] - 1);
 	ptr = ranlist_head[stream];
 
 	for (i = 0; i < r; i++) {
@@ -196,43 +634,170 @@ long Random::deal_random_number(int stream = 0) {
 	}
 
 	deal = ptr->number;
-	ranlist_top--;
+	ranlist_top[stream]--;
 
 	if (prior == NULL)
-		ranlist_head[stream] = ptr;
+		ranlist_head[stream] = ptr->next;
 	else
 		prior->next = ptr->next;
+	delete ptr;
 
 	return deal;
 }
 
 // Private
 
+/**
+* Release a stream's alias table.
+* @param stream   the stream whose table is released.
+*/
+void Random::free_alias_table(int stream) {
+	delete[] alias_prob[stream];
+	delete[] alias_index[stream];
+	alias_prob[stream] = NULL;
+	alias_index[stream] = NULL;
+	alias_size[stream] = 0;
+}
+
+/**
+* The slow path of normal: the wedges and the tail beyond ZIGGURAT_NORMAL_R.
+* @param stream  the stream to select from.
+* @param j       signed position drawn for layer i.
+* @param i       the layer.
+*/
+double Random::normal_tail(int stream, long j, int i) {
+	const ziggurat_type &ziggurat = ziggurat_tables();
+	const double r = ZIGGURAT_NORMAL_R;
+	double x, y;
+	long z;
+
+	for (;;) {
+		x = j * ziggurat.wn[i];
+		if (i == 0) {
+			do {
+				x = -log(unif(stream)) / r;
+				y = -log(unif(stream));
+			} while (y + y < x * x);
+			return j > 0 ? r + x : -r - x;
+		}
+		if (ziggurat.fn[i] + unif(stream) * (ziggurat.fn[i - 1] - ziggurat.fn[i]) < exp(-0.5 * x * x))
+			return x;
+
+		z = next(stream);
+		i = (int) (z & (ZIGGURAT_NORMAL_LAYERS - 1));
+		j = (z >> 7) - (1L << 23);
+		if (labs(j) < ziggurat.kn[i])
+			return j * ziggurat.wn[i];
+	}
+}
+
+/**
+* The slow path of exponential: the wedges and the tail beyond ZIGGURAT_EXPONENTIAL_R.
+* @param stream  the stream to select from.
+* @param j       position drawn for layer i.
+* @param i       the layer.
+*/
+double Random::exponential_tail(int stream, long j, int i) {
+	const ziggurat_type &ziggurat = ziggurat_tables();
+	double x;
+	long z;
+
+	for (;;) {
+		if (i == 0)
+			return ZIGGURAT_EXPONENTIAL_R - log(unif(stream));
+		x = j * ziggurat.we[i];
+		if (ziggurat.fe[i] + unif(stream) * (ziggurat.fe[i - 1] - ziggurat.fe[i]) < exp(-x))
+			return x;
+
+		z = next(stream);
+		i = (int) (z & (ZIGGURAT_EXPONENTIAL_LAYERS - 1));
+		j = z >> 8;
+		if (j < ziggurat.ke[i])
+			return j * ziggurat.we[i];
+	}
+}
+
+/**
+* Poisson deviates for larger means by transformed rejection with squeeze (PTRS, Hormann 1993).
+* @param stream the stream to select from.
+* @param mean  average value, POISSON_INVERSION_LIMIT or more.
+*/
+long Random::poisson_ptrs(int stream, double mean) {
+	const double slam = sqrt(mean);
+	const double loglam = log(mean);
+	const double b = 0.931 + 2.53 * slam;
+	const double a = -0.059 + 0.02483 * b;
+	const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+	const double vr = 0.9277 - 3.6224 / (b - 2.0);
+	double u, v, us;
+	long k;
+
+	for (;;) {
+		u = unif(stream) - 0.5;
+		v = unif(stream);
+		us = 0.5 - fabs(u);
+		k = (long) floor((2.0 * a / us + b) * u + mean + 0.43);
+		if (us >= 0.07 && v <= vr)
+			return k;
+		if (k < 0 || (us < 0.013 && v > us))
+			continue;
+		if (log(v) + log(invalpha) - log(a / (us * us) + b) <= -mean + k * loglam - lgamma(k + 1.0))
+			return k;
+	}
+}
+
+/**
+* Release whatever remains of a stream's deal list.
+* @param stream   the stream whose list is released.
+*/
+void Random::free_random_list(int stream) {
+	ranlist_type *ptr = ranlist_head[stream];
+
+	while (ptr != NULL) {
+		ranlist_type *next = ptr->next;
+		delete ptr;
+		ptr = next;
+	}
+	ranlist_head[stream] = NULL;
+	ranlist_top[stream] = 0;
+}
+
 /**
 * Computes a 'random' uniformly distributed value for the input stream.
-* Uses the L'Ecuyer algorithm.
 * @param stream   stream to be used (default = 0).
+* @return a double value in the interval (0.0, 1.0)
 */
 double Random::unif(int stream = 0) {
+	const double normalize = 1.0 / 2147483563;
+	return ((double) next(stream) * normalize);
+}
+
+/**
+* Advances a stream and returns its raw value.
+* Uses the L'Ecuyer algorithm.
+* @param stream   stream to be used.
+* @return a long value in the interval [1, 2147483562]
+*/
+long Random::next(int stream) {
 	const long m1 = 2147483563;
 	const long a1 = 40014;
 	const long q1 = 53668;
 	const long r1 = 12211;
-	const long m2 = 2147483199;
+	const long m2 = 2147483399;
 	const long a2 = 40692;
 	const long q2 = 52774;
 	const long r2 = 3791;
 	const long m1_minus_1 = m1 - 1;
-	const double normalize = 4.656613e-10;
 	long q;
-	double z;
+	long z;
 
+	draw_count[stream]++;
 	q = seed[stream].seed_1 / q1;
 	seed[stream].seed_1 = a1 * (seed[stream].seed_1 - q * q1) - q * r1;
 	if (seed[stream].seed_1 < 0)
 		seed[stream].seed_1 += m1;
 
-	q = seed[stream].seed_2 / q1;
+	q = seed[stream].seed_2 / q2;
 	seed[stream].seed_2 = a2 * (seed[stream].seed_2 - q * q2) - q * r2;
 	if (seed[stream].seed_2 < 0)
 		seed[stream].seed_2 += m2;
@@ -240,7 +805,7 @@ double Random::unif(int stream = 0) {
 	z = seed[stream].seed_1 - seed[stream].seed_2;
 	while (z < 1)
 		z += m1_minus_1;
-	return ((double) z * normalize);
+	return z;
 }
 
 //
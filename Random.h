@@ -6,6 +6,14 @@
 //----------------------------------------------------------------------------
 // DESIGN NOTES
 //    Uses the L'Ecuyer algorithm
+//    Normal and exponential deviates use the Ziggurat method of Marsaglia
+//    and Tsang, Poisson uses inversion or Hormann's PTRS, Zipf uses
+//    rejection-inversion and discrete distributions use Vose's alias table,
+//    so each usually costs a single draw from the stream.
+//    An instance is not shared between threads: give each thread its own,
+//    e.g. Random(master, thread).  Instances are cache line aligned so that
+//    generators of neighbouring threads never share a line, and cannot be
+//    copied since a copy would silently repeat the same streams.
 //----------------------------------------------------------------------------
 // REVISION HISTORY
 //
@@ -28,6 +36,7 @@
 // DEFINES
 //
 #define MAX_RANDOM_STREAMS  8
+#define RANDOM_CACHE_LINE   64
 
 typedef struct ranlist {
 	long number;
@@ -44,30 +53,60 @@ typedef seed_type seed_array[MAX_RANDOM_STREAMS];
 //----------------------------------------------------------------------------
 //	 Begin Code
 
-class Random {
+class alignas(RANDOM_CACHE_LINE) Random {
 
 public:
 	Random();
+	explicit Random(unsigned long long master, unsigned long long thread = 0);
 	~Random();
 	void reset(int stream);
 	double duniform(int stream, double lower, double upper);
 	long uniform(int stream, long lower, long upper);
 	double normal(int stream, double mean, double sigma);
+	double exponential(int stream, double mean);
+	long poisson(int stream, double mean);
+	long zipf(int stream, long n, double exponent);
+	void normal_batch(int stream, double mean, double sigma, double *out, long count);
+	void exponential_batch(int stream, double mean, double *out, long count);
+	void poisson_batch(int stream, double mean, long *out, long count);
+	void zipf_batch(int stream, long n, double exponent, long *out, long count);
+	void create_alias_table(int stream, const double *weights, long n);
+	long alias(int stream);
+	void alias_batch(int stream, long *out, long count);
 	void create_random_list(int stream, long list_length);
 	long deal_random_number(int stream);
 	bool random_boolean (int stream, int pcnt);
 	bool random_boolean (int stream);
+	void set_seed (unsigned long long master);
+	void set_seed (unsigned long long master, unsigned long long thread);
+	void get_state (seed_array state) const;
+	void set_state (const seed_array state);
+	unsigned long long draws (int stream) const { return draw_count[stream]; }
+	void reset_draws (void);
 
 private:
-	// Data
-    seed_array initial_seed_array;
+	Random(const Random&) = delete;
+	Random& operator=(const Random&) = delete;
+
+	// Data, the state touched on every draw first
 	seed_array seed;
-	long ranlist_top;
+	unsigned long long draw_count[MAX_RANDOM_STREAMS];
+    seed_array initial_seed_array;
+	long ranlist_top[MAX_RANDOM_STREAMS];
 	ranlist_type *ranlist_head[MAX_RANDOM_STREAMS];
+	long alias_size[MAX_RANDOM_STREAMS];
+	double *alias_prob[MAX_RANDOM_STREAMS];
+	long *alias_index[MAX_RANDOM_STREAMS];
 
 	// Methods
 	double unif(int stream);
+	long   next(int stream);
 	void   init(void);
+	void   free_random_list(int stream);
+	void   free_alias_table(int stream);
+	double normal_tail(int stream, long j, int i);
+	double exponential_tail(int stream, long j, int i);
+	long   poisson_ptrs(int stream, double mean);
 
 };
 
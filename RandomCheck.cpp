@@ -0,0 +1,484 @@
+/****************************************************************************/
+/* BEGIN FILE             RandomCheck.cpp                                   */
+/****************************************************************************/
+/* PURPOSE                                                                  */
+/*        Distribution, stream independence and throughput checks of        */
+/*        Random.                                                           */
+/****************************************************************************/
+/* DESIGN NOTES                                                             */
+/*        Every check uses a stream of its own, so one check's draws never  */
+/*        shift another's.  Chi-square p-values use the Wilson-Hilferty     */
+/*        approximation and Kolmogorov-Smirnov ones the asymptotic series.  */
+/****************************************************************************/
+/* REVISION HISTORY                                                         */
+/*                                                                          */
+/*   Initial Code:                                                          */
+/*                                     19OCT26                              */
+/*                                                                          */
+/*   Modifications:                                                         */
+/*                                                                          */
+/****************************************************************************/
+/* INCLUDE FILES                                                            */
+/*                                                                          */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "RandomCheck.h"
+
+/*                                                                          */
+/****************************************************************************/
+/* DEFINES/NAMESPACES                                                       */
+/*                                                                          */
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static const long Chunk = 65536;
+static const long DeckSize = 52;
+static const unsigned long long MaxDeals = 200000;
+static const double MinExpected = 5.0;      // Chi-square cells are pooled until they expect this many
+
+/**
+* Two sided p-value of a standard normal statistic.
+*/
+static double normalP (double z) {
+    return erfc (fabs (z) / sqrt (2.0));
+}
+
+/**
+* Upper tail p-value of a chi-square statistic (Wilson-Hilferty).
+*/
+static double chiSquareP (double x, long df) {
+    if (df < 1)
+        return 1.0;
+    const double k = 2.0 / (9.0 * df);
+    const double z = (pow (x / df, 1.0 / 3.0) - (1.0 - k)) / sqrt (k);
+    return 0.5 * erfc (z / sqrt (2.0));
+}
+
+/**
+* Chi-square statistic of observed counts against expected ones, pooling
+* neighbouring cells until each expects at least MinExpected.
+* @param df  receives the degrees of freedom.
+*/
+static double chiSquare (const vector<double>& observed, const vector<double>& expected, long& df) {
+    vector<double> o (1, 0.0);
+    vector<double> e (1, 0.0);
+    for (size_t i = 0; i < observed.size (); i++) {
+        if (e.back () >= MinExpected) {
+            o.push_back (0.0);
+            e.push_back (0.0);
+        }
+        o.back () += observed[i];
+        e.back () += expected[i];
+    }
+    // A last cell expecting too little joins the one before it.
+    if (e.size () > 1 && e.back () < MinExpected) {
+        o[o.size () - 2] += o.back ();
+        e[e.size () - 2] += e.back ();
+        o.pop_back ();
+        e.pop_back ();
+    }
+    double x = 0.0;
+    for (size_t i = 0; i < o.size (); i++)
+        x += e[i] > 0.0 ? (o[i] - e[i]) * (o[i] - e[i]) / e[i] : o[i];
+    df = (long) o.size () - 1;
+    return x;
+}
+
+/**
+* Kolmogorov-Smirnov p-value of the largest distance d between n samples and a distribution.
+*/
+static double kolmogorovP (double d, size_t n) {
+    const double rn = sqrt ((double) n);
+    const double lambda = (rn + 0.12 + 0.11 / rn) * d;
+    if (lambda < 0.2)
+        return 1.0;
+    double p = 0.0;
+    for (int k = 1; k <= 100; k++)
+        p += ((k & 1) ? 2.0 : -2.0) * exp (-2.0 * k * k * lambda * lambda);
+    return min (1.0, max (0.0, p));
+}
+
+/**
+* Largest distance between the empirical distribution of samples and a distribution function.
+* @param x    the samples; sorted in place.
+* @param cdf  the distribution function they should follow.
+*/
+static double kolmogorovD (vector<double>& x, const function<double (double)>& cdf) {
+    sort (x.begin (), x.end ());
+    const double n = (double) x.size ();
+    double d = 0.0;
+    for (size_t i = 0; i < x.size (); i++) {
+        const double f = cdf (x[i]);
+        d = max (d, max (f - i / n, (i + 1) / n - f));
+    }
+    return d;
+}
+
+/**
+* Draw count values chunk by chunk, timing only the drawing.
+* @param count  the number of values.
+* @param draw   fills a buffer with the given number of values.
+* @param use    consumes a filled buffer.
+* @return the seconds spent drawing.
+*/
+template <typename T, typename Draw, typename Use>
+static double sample (unsigned long long count, Draw draw, Use use) {
+    vector<T> buffer ((size_t) min<unsigned long long> (count, Chunk));
+    double seconds = 0.0;
+    for (unsigned long long done = 0; done < count; ) {
+        const long m = (long) min<unsigned long long> (Chunk, count - done);
+        const Clock::time_point start = Clock::now ();
+        draw (buffer.data (), m);
+        seconds += chrono::duration<double> (Clock::now () - start).count ();
+        use (buffer.data (), m);
+        done += (unsigned long long) m;
+    }
+    return seconds;
+}
+
+/**
+* Append one line of the report.
+* @param statistic  what was measured, e.g. "chi2 7.81 df 9".
+* @param p          p-value of the check; 0 for a broken exact property.
+* @param samples    values drawn.
+* @param seconds    time spent drawing them.
+* @return true if the check passed.
+*/
+static bool verdict (string& report, const char* name, const string& statistic, double p,
+                     unsigned long long samples, double seconds) {
+    const bool ok = p >= RandomCheck::MinPValue;
+    char s[200];
+    snprintf (s, sizeof (s), "%-22s %-30s p %-10.3g %8.1f M/s  %s\n", name, statistic.c_str (), p,
+              seconds > 0.0 ? samples / seconds / 1.0e6 : 0.0, ok ? "ok" : "FAIL");
+    report.append (s);
+    return ok;
+}
+
+/**
+* Describe a statistic and its parameter for the report.
+*/
+static string describe (const char* what, double value, const char* unit, double parameter) {
+    char s[64];
+    snprintf (s, sizeof (s), "%s %.4g %s %.4g", what, value, unit, parameter);
+    return s;
+}
+
+/**
+* Check counts of a discrete sampler against its probabilities.
+*/
+static bool discrete (string& report, const char* name, const vector<double>& counts,
+                      const vector<double>& probabilities, unsigned long long samples, double seconds) {
+    vector<double> expected (probabilities.size ());
+    for (size_t i = 0; i < probabilities.size (); i++)
+        expected[i] = probabilities[i] * samples;
+    long df = 0;
+    const double x = chiSquare (counts, expected, df);
+    return verdict (report, name, describe ("chi2", x, "df", (double) df), chiSquareP (x, df), samples, seconds);
+}
+
+/**
+* Check a Poisson sampler of one mean.
+*/
+static bool poisson (string& report, const char* name, Random& random, int stream, double mean, unsigned long long samples) {
+    const long cells = (long) (mean + 20.0 * sqrt (mean) + 20.0);
+    vector<double> counts (cells + 1);
+    vector<double> probabilities (cells + 1);
+    double total = 0.0;
+    for (long k = 0; k < cells; k++) {
+        probabilities[k] = exp (-mean + k * log (mean) - lgamma (k + 1.0));
+        total += probabilities[k];
+    }
+    probabilities[cells] = max (0.0, 1.0 - total);
+    const double seconds = sample<long> (samples, [&] (long* out, long m) { random.poisson_batch (stream, mean, out, m); },
+                                         [&] (const long* in, long m) {
+        for (long i = 0; i < m; i++)
+            counts[min (max (in[i], 0L), cells)]++;
+    });
+    return discrete (report, name, counts, probabilities, samples, seconds);
+}
+
+/****************************************************************************/
+
+/**
+* Run every check and describe the results, one line per check.
+* @param samples  values drawn by each check.
+* @param seed     master seed of the random streams.
+* @param report   receives the results.
+* @return false if any check failed.
+*/
+bool RandomCheck::run (unsigned long long samples, unsigned long long seed, string& report) {
+    const unsigned long long n = max (samples, 1ULL);
+    const unsigned long long ks = min (n, KolmogorovSamples);
+    Random random (seed);
+    bool ok = true;
+    double seconds;
+    char s[64];
+
+    // uniform: every value of [lower, upper] equally likely, and lower for a reversed range.
+    {
+        const long k = 10;
+        vector<double> counts (k);
+        long outside = 0;
+        seconds = sample<long> (n, [&] (long* out, long m) {
+            for (long i = 0; i < m; i++)
+                out[i] = random.uniform (0, 0, k - 1);
+        }, [&] (const long* in, long m) {
+            for (long i = 0; i < m; i++)
+                if (in[i] < 0 || in[i] >= k)
+                    outside++;
+                else
+                    counts[in[i]]++;
+        });
+        const bool reversed = random.uniform (0, 5, 2) == 5;
+        ok &= discrete (report, "uniform", counts, vector<double> (k, 1.0 / k), n, seconds);
+        if (outside > 0 || !reversed)
+            ok &= verdict (report, "uniform range", outside > 0 ? "values outside [lower, upper]" : "reversed range", 0.0, n, seconds);
+    }
+
+    // duniform: Kolmogorov-Smirnov against U[lower, upper).
+    {
+        const double lower = -2.0;
+        const double upper = 3.0;
+        vector<double> x;
+        x.reserve ((size_t) ks);
+        long outside = 0;
+        seconds = sample<double> (n, [&] (double* out, long m) {
+            for (long i = 0; i < m; i++)
+                out[i] = random.duniform (1, lower, upper);
+        }, [&] (const double* in, long m) {
+            for (long i = 0; i < m; i++) {
+                outside += in[i] < lower || in[i] >= upper;
+                if (x.size () < ks)
+                    x.push_back (in[i]);
+            }
+        });
+        const double d = kolmogorovD (x, [&] (double v) { return (v - lower) / (upper - lower); });
+        ok &= verdict (report, "duniform", describe ("ks", d, "n", (double) x.size ()),
+                       outside > 0 ? 0.0 : kolmogorovP (d, x.size ()), n, seconds);
+    }
+
+    // normal: Kolmogorov-Smirnov, plus the count beyond four sigma which a sum of uniforms gets wrong.
+    {
+        const double mean = 1.5;
+        const double sigma = 2.0;
+        const double tail = 6.334248366623996e-5;   // P (|Z| > 4)
+        vector<double> x;
+        x.reserve ((size_t) ks);
+        double beyond = 0.0;
+        seconds = sample<double> (n, [&] (double* out, long m) { random.normal_batch (2, mean, sigma, out, m); },
+                                  [&] (const double* in, long m) {
+            for (long i = 0; i < m; i++) {
+                beyond += fabs (in[i] - mean) > 4.0 * sigma;
+                if (x.size () < ks)
+                    x.push_back (in[i]);
+            }
+        });
+        const double d = kolmogorovD (x, [&] (double v) { return 0.5 * erfc (-(v - mean) / (sigma * sqrt (2.0))); });
+        ok &= verdict (report, "normal", describe ("ks", d, "n", (double) x.size ()), kolmogorovP (d, x.size ()), n, seconds);
+        const double z = (beyond - n * tail) / sqrt (n * tail * (1.0 - tail));
+        ok &= verdict (report, "normal tails", describe ("4 sigma", beyond, "expected", n * tail), normalP (z), n, seconds);
+    }
+
+    // exponential: Kolmogorov-Smirnov against 1 - exp (-x / mean).
+    {
+        const double mean = 2.0;
+        vector<double> x;
+        x.reserve ((size_t) ks);
+        long negative = 0;
+        seconds = sample<double> (n, [&] (double* out, long m) { random.exponential_batch (3, mean, out, m); },
+                                  [&] (const double* in, long m) {
+            for (long i = 0; i < m; i++) {
+                negative += in[i] < 0.0;
+                if (x.size () < ks)
+                    x.push_back (in[i]);
+            }
+        });
+        const double d = kolmogorovD (x, [&] (double v) { return v <= 0.0 ? 0.0 : -expm1 (-v / mean); });
+        ok &= verdict (report, "exponential", describe ("ks", d, "n", (double) x.size ()),
+                       negative > 0 ? 0.0 : kolmogorovP (d, x.size ()), n, seconds);
+    }
+
+    // poisson: both the inversion and the PTRS method.
+    ok &= poisson (report, "poisson 4 (inversion)", random, 4, 4.0, n);
+    ok &= poisson (report, "poisson 30 (ptrs)", random, 4, 30.0, n);
+
+    // zipf: P (k) proportional to 1 / k^s over [1, n].
+    {
+        const long size = 100;
+        const double exponent = 1.1;
+        vector<double> counts (size + 1);
+        vector<double> probabilities (size + 1);
+        double total = 0.0;
+        for (long k = 1; k <= size; k++)
+            total += pow ((double) k, -exponent);
+        for (long k = 1; k <= size; k++)
+            probabilities[k] = pow ((double) k, -exponent) / total;
+        seconds = sample<long> (n, [&] (long* out, long m) { random.zipf_batch (5, size, exponent, out, m); },
+                                [&] (const long* in, long m) {
+            for (long i = 0; i < m; i++)
+                counts[min (max (in[i], 0L), size)]++;
+        });
+        counts[1] += counts[0];     // Out of range values land in a cell that cannot absorb them
+        ok &= discrete (report, "zipf 100 (1.1)", counts, probabilities, n, seconds);
+    }
+
+    // alias: the weights, zero weights never drawn.
+    {
+        const double weights[] = { 1.0, 2.0, 3.0, 4.0, 0.0, 10.0 };
+        const long size = sizeof (weights) / sizeof (weights[0]);
+        vector<double> counts (size + 1);
+        vector<double> probabilities (size + 1);
+        for (long i = 0; i < size; i++)
+            probabilities[i] = weights[i] / 20.0;
+        random.create_alias_table (6, weights, size);
+        seconds = sample<long> (n, [&] (long* out, long m) { random.alias_batch (6, out, m); },
+                                [&] (const long* in, long m) {
+            for (long i = 0; i < m; i++)
+                counts[in[i] >= 0 && in[i] < size ? in[i] : size]++;
+        });
+        if (counts[4] > 0 || counts[size] > 0)
+            ok &= verdict (report, "alias", "zero weight or invalid value drawn", 0.0, n, seconds);
+        else
+            ok &= discrete (report, "alias", counts, probabilities, n, seconds);
+    }
+
+    // random_boolean: the percentage, drawn from the given stream and no other.
+    {
+        const int percent = 30;
+        seed_array before;
+        seed_array after;
+        random.get_state (before);
+        const unsigned long long drawn = random.draws (7);
+        double hits = 0.0;
+        seconds = sample<char> (n, [&] (char* out, long m) {
+            for (long i = 0; i < m; i++)
+                out[i] = random.random_boolean (7, percent);
+        }, [&] (const char* in, long m) {
+            for (long i = 0; i < m; i++)
+                hits += in[i];
+        });
+        random.get_state (after);
+        bool isolated = random.draws (7) - drawn == n;
+        for (int i = 0; i < MAX_RANDOM_STREAMS - 1; i++)
+            isolated &= memcmp (&before[i], &after[i], sizeof (seed_type)) == 0;
+        const double p = percent / 100.0;
+        const double z = (hits - n * p) / sqrt (n * p * (1.0 - p));
+        if (isolated)
+            ok &= verdict (report, "random_boolean 30%", describe ("true", hits / n * 100.0, "% of", (double) n), normalP (z), n, seconds);
+        else
+            ok &= verdict (report, "random_boolean 30%", "drew from another stream", 0.0, n, seconds);
+    }
+
+    // deal_random_number: every deal a permutation, then -1; the first card uniform.
+    {
+        const unsigned long long deals = max (1ULL, min (n / DeckSize, MaxDeals));
+        vector<double> first (DeckSize);
+        vector<char> seen (DeckSize);
+        bool permutations = true;
+        const Clock::time_point start = Clock::now ();
+        for (unsigned long long d = 0; d < deals; d++) {
+            random.create_random_list (0, DeckSize);
+            fill (seen.begin (), seen.end (), 0);
+            for (long c = 0; c < DeckSize; c++) {
+                const long card = random.deal_random_number (0);
+                if (card < 0 || card >= DeckSize || seen[card]) {
+                    permutations = false;
+                    break;
+                }
+                seen[card] = 1;
+                if (c == 0)
+                    first[card]++;
+            }
+            permutations &= random.deal_random_number (0) == -1;
+        }
+        seconds = chrono::duration<double> (Clock::now () - start).count ();
+        if (permutations)
+            ok &= discrete (report, "deal 52 (first card)", first, vector<double> (DeckSize, 1.0 / DeckSize), deals, seconds);
+        else
+            ok &= verdict (report, "deal 52", "a deal was not a permutation", 0.0, deals, seconds);
+    }
+
+    // Independence: correlation between every pair of streams, between consecutive
+    // draws of each stream, and between the first stream of two threads.
+    {
+        struct Row {
+            double x[MAX_RANDOM_STREAMS + 1];
+        };
+        Random other (seed, 1);
+        const int pairs = MAX_RANDOM_STREAMS * (MAX_RANDOM_STREAMS - 1) / 2;
+        const int tests = pairs + MAX_RANDOM_STREAMS + 1;
+        vector<double> products (tests);
+        double previous[MAX_RANDOM_STREAMS] = { 0.0 };
+        seconds = sample<Row> (n, [&] (Row* out, long m) {
+            for (long i = 0; i < m; i++) {
+                for (int j = 0; j < MAX_RANDOM_STREAMS; j++)
+                    out[i].x[j] = random.duniform (j, -0.5, 0.5);
+                out[i].x[MAX_RANDOM_STREAMS] = other.duniform (0, -0.5, 0.5);
+            }
+        }, [&] (const Row* in, long m) {
+            for (long i = 0; i < m; i++) {
+                const double* x = in[i].x;
+                int t = 0;
+                for (int a = 0; a < MAX_RANDOM_STREAMS; a++)
+                    for (int b = a + 1; b < MAX_RANDOM_STREAMS; b++)
+                        products[t++] += x[a] * x[b];
+                for (int a = 0; a < MAX_RANDOM_STREAMS; a++) {
+                    products[t++] += x[a] * previous[a];
+                    previous[a] = x[a];
+                }
+                products[t] += x[0] * x[MAX_RANDOM_STREAMS];
+            }
+        });
+        // Centred uniform deviates have variance 1/12, so r = 12 * mean product and sqrt (n) * r ~ N (0, 1).
+        double worst = 0.0;
+        for (int t = 0; t < tests; t++)
+            worst = max (worst, fabs (12.0 * products[t] / n));
+        snprintf (s, sizeof (s), "max |r| %.3g of %d pairs", worst, tests);
+        ok &= verdict (report, "stream independence", s, min (1.0, tests * normalP (worst * sqrt ((double) n))),
+                       n * (MAX_RANDOM_STREAMS + 1), seconds);
+    }
+
+    // Batches: exactly the values the single sample methods give from the same state.
+    {
+        Random single (seed, 2);
+        Random batched (seed, 2);
+        const double weights[] = { 3.0, 1.0, 4.0, 1.0, 5.0 };
+        single.create_alias_table (6, weights, 5);
+        batched.create_alias_table (6, weights, 5);
+        const long m = (long) min<unsigned long long> (n, Chunk);
+        vector<double> d (m);
+        vector<long> l (m);
+        bool same = true;
+        const Clock::time_point start = Clock::now ();
+        batched.normal_batch (2, 0.0, 1.0, d.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= d[i] == single.normal (2, 0.0, 1.0);
+        batched.exponential_batch (3, 1.0, d.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= d[i] == single.exponential (3, 1.0);
+        batched.poisson_batch (4, 7.5, l.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= l[i] == single.poisson (4, 7.5);
+        batched.poisson_batch (4, 75.0, l.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= l[i] == single.poisson (4, 75.0);
+        batched.zipf_batch (5, 1000, 1.3, l.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= l[i] == single.zipf (5, 1000, 1.3);
+        batched.alias_batch (6, l.data (), m);
+        for (long i = 0; i < m; i++)
+            same &= l[i] == single.alias (6);
+        seconds = chrono::duration<double> (Clock::now () - start).count ();
+        ok &= verdict (report, "batch = single", same ? "identical sequences" : "sequences differ", same ? 1.0 : 0.0, 12ULL * m, seconds);
+    }
+
+    return ok;
+}
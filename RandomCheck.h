@@ -0,0 +1,51 @@
+/*****************************************************************************/
+/* BEGIN HEADER FILE     RandomCheck.h                                       */
+/*****************************************************************************/
+/* PURPOSE                                                                   */
+/*     Statistical checks and throughput figures for every Random API, so    */
+/*     that a faster generator or batch kernel can be shown to draw from     */
+/*     the same distributions before it replaces the current one.            */
+/*****************************************************************************/
+/* DESIGN NOTES                                                              */
+/*     Each check draws the requested number of samples, timing only the     */
+/*     drawing, and tests them with chi-square (discrete), Kolmogorov-       */
+/*     Smirnov (continuous) or a normal approximation.  A check fails when   */
+/*     its p-value falls below MinPValue.  Run with --random-check.          */
+/*****************************************************************************/
+/* REVISION HISTORY                                                          */
+/*   Initial code:                     19OCT26                               */
+/*   Modifications:                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*  SAFETY DEFINITION                                                        */
+/*                                                                           */
+
+#ifndef   _RANDOMCHECK_H_
+#define   _RANDOMCHECK_H_
+
+/*                                                                           */
+/*****************************************************************************/
+/*  INCLUDE FILES                                                            */
+/*                                                                           */
+
+#pragma once
+
+#include <string>
+#include "Random.h"
+
+
+class RandomCheck {
+
+public:
+	static constexpr double MinPValue = 1.0e-6;
+	static constexpr unsigned long long KolmogorovSamples = 1000000;
+
+	static bool run (unsigned long long samples, unsigned long long seed, std::string& report);
+
+};
+
+
+#endif
+/*                                                                           */
+/* END HEADER FILE    RandomCheck.h                                          */
+/*****************************************************************************/
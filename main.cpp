@@ -1,10 +1,14 @@
-#include "loremipsum.h"
-#include <QtWidgets/QApplication>
-
-int main(int argc, char *argv[])
-{
-    QApplication a(argc, argv);
-    LoremIpsum w;
-    w.show();
-    return a.exec();
-}
+#include "loremipsum.h"
+#include "LoremCli.h"
+#include <QtWidgets/QApplication>
+
+int main(int argc, char *argv[])
+{
+    if (isCommandLine(argc, argv))
+        return runCommandLine(argc, argv);
+
+    QApplication a(argc, argv);
+    LoremIpsum w;
+    w.show();
+    return a.exec();
+}